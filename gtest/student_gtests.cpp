@@ -1,8 +1,1160 @@
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <filesystem>
+#include <random>
+
 #include "dijkstras.h"
+#include "graph_io.h"
+#include "shortest_path.h"
+#include "contraction.h"
+#include "batch.h"
+#include "delta_stepping.h"
+#include "dynamic_sssp.h"
+#include "tree_export.h"
+#include "graph_gen.h"
+#include "dictionary.h"
+#include "word_index.h"
+#include "word_components.h"
+#include "word_trie.h"
+#include "edit_distance.h"
+#include "ladder_batch.h"
 #include "ladder.h"
+#include "stats.h"
+
+static string data_file(const string& name) {
+  return string(HW9_DATA_DIR) + "/" + name;
+}
+
+TEST(Dijkstra, SmallGraphDistances) {
+  Graph G;
+  file_to_graph(data_file("small.txt"), G);
+  vector<int> previous;
+  vector<int> distances = dijkstra_shortest_path(G, 0, previous);
+  EXPECT_EQ(distances, (vector<int>{0, 3, 6, 1}));
+  EXPECT_EQ(extract_shortest_path(distances, previous, 2), (vector<int>{0, 3, 1, 2}));
+}
+
+TEST(Dijkstra, CSRGraphMatchesAdjacencyList) {
+  for (const string name : {"small.txt", "medium.txt", "large.txt", "largest.txt"}) {
+    Graph G;
+    file_to_graph(data_file(name), G);
+    CSRGraph C;
+    file_to_graph(data_file(name), C);
+    ASSERT_EQ(C.num_vertices(), G.numVertices) << name;
+    EXPECT_EQ(C.num_edges(), CSRGraph(G).num_edges()) << name;
+
+    for (int s = 0; s < G.numVertices; ++s) {
+      vector<int> prev_list, prev_csr;
+      vector<int> d_list = dijkstra_shortest_path(G, s, prev_list);
+      vector<int> d_csr = dijkstra_shortest_path(C, s, prev_csr);
+      EXPECT_EQ(d_list, d_csr) << name << " source " << s;
+      EXPECT_EQ(prev_list, prev_csr) << name << " source " << s;
+    }
+  }
+}
+
+TEST(Dijkstra, CSRGraphRejectsOutOfRangeEdges) {
+  istringstream in("2\n0 1 4\n1 5 2\n");
+  CSRGraph C;
+  EXPECT_THROW(in >> C, runtime_error);
+}
+
+static void expect_same_graph(const CSRGraph& a, const CSRGraph& b) {
+  ASSERT_EQ(a.num_vertices(), b.num_vertices());
+  ASSERT_EQ(a.num_edges(), b.num_edges());
+  for (int u = 0; u < a.num_vertices(); ++u) {
+    ASSERT_EQ(a.edges_begin(u), b.edges_begin(u));
+    ASSERT_EQ(a.edges_end(u), b.edges_end(u));
+  }
+  for (int i = 0; i < a.num_edges(); ++i) {
+    EXPECT_EQ(a.edge_dst(i), b.edge_dst(i));
+    EXPECT_EQ(a.edge_weight(i), b.edge_weight(i));
+  }
+}
+
+TEST(GraphIO, MappedTextParserMatchesIstream) {
+  for (const string name : {"small.txt", "medium.txt", "large.txt", "largest.txt"}) {
+    ifstream in(data_file(name));
+    Graph expected;
+    in >> expected;
+
+    Graph G;
+    load_graph_text(data_file(name), G);
+    ASSERT_EQ(G.numVertices, expected.numVertices) << name;
+    for (int u = 0; u < G.numVertices; ++u) {
+      ASSERT_EQ(G[u].size(), expected[u].size()) << name;
+      for (size_t i = 0; i < G[u].size(); ++i) {
+        EXPECT_EQ(G[u][i].dst, expected[u][i].dst);
+        EXPECT_EQ(G[u][i].weight, expected[u][i].weight);
+      }
+    }
+
+    CSRGraph C;
+    load_graph_text(data_file(name), C);
+    expect_same_graph(C, CSRGraph(expected));
+  }
+}
+
+TEST(GraphIO, ScannerStopsLikeIstream) {
+  CSRGraph C;
+  parse_graph_text("3\n0 1 5\n1 2 -2\n2 0 x 1 1\n", C);
+  EXPECT_EQ(C.num_vertices(), 3);
+  EXPECT_EQ(C.num_edges(), 2);
+  EXPECT_EQ(C.edge_weight(C.edges_begin(1)), -2);
+
+  EXPECT_THROW(parse_graph_text("", C), runtime_error);
+  EXPECT_THROW(parse_graph_text("2\n0 3 1\n", C), runtime_error);
+  EXPECT_THROW(parse_graph_text("2\n0 1 99999999999\n", C), runtime_error);
+}
+
+TEST(GraphIO, BinaryRoundTrip) {
+  string bin = testing::TempDir() + "largest.bin";
+  CSRGraph text;
+  file_to_graph(data_file("largest.txt"), text);
+  save_graph_binary(bin, text);
+  ASSERT_TRUE(is_graph_binary(bin));
+  EXPECT_FALSE(is_graph_binary(data_file("largest.txt")));
+
+  CSRGraph mapped;
+  load_graph_binary(bin, mapped);
+  expect_same_graph(mapped, text);
+
+  CSRGraph detected;
+  file_to_graph(bin, detected);
+  expect_same_graph(detected, text);
+
+  CSRGraph copy = mapped;
+  mapped = CSRGraph();
+  vector<int> prev_text, prev_copy;
+  EXPECT_EQ(dijkstra_shortest_path(copy, 0, prev_copy), dijkstra_shortest_path(text, 0, prev_text));
+  remove(bin.c_str());
+}
+
+TEST(GraphIO, CorruptBinaryThrows) {
+  string bin = testing::TempDir() + "corrupt.bin";
+  CSRGraph G;
+  parse_graph_text("3\n0 1 5\n1 2 2\n2 0 1\n", G);
+  auto corrupt = [&](size_t index, int value) {
+    save_graph_binary(bin, G);
+    fstream f(bin, ios::in | ios::out | ios::binary);
+    f.seekp(sizeof(GraphFileHeader) + index * sizeof(int32_t));
+    f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  CSRGraph mapped;
+  // offsets 是下标 0..3（0 1 2 3），dst 是 4..6
+  corrupt(1, 3);
+  EXPECT_THROW(load_graph_binary(bin, mapped), runtime_error);
+  corrupt(5, 3);
+  EXPECT_THROW(load_graph_binary(bin, mapped), runtime_error);
+  corrupt(4, -1);
+  EXPECT_THROW(load_graph_binary(bin, mapped), runtime_error);
+  corrupt(6, 0);
+  EXPECT_NO_THROW(load_graph_binary(bin, mapped));
+  remove(bin.c_str());
+}
+
+TEST(GraphIO, MissingFileThrows) {
+  Graph G;
+  EXPECT_THROW(file_to_graph(data_file("no_such_graph.txt"), G), runtime_error);
+}
+
+static CSRGraph random_graph(int n, int m, int max_weight, unsigned seed) {
+  mt19937 rng(seed);
+  uniform_int_distribution<int> vertex(0, n - 1), weight(0, max_weight);
+  Graph G;
+  G.numVertices = n;
+  G.resize(n);
+  for (int i = 0; i < m; ++i) {
+    int u = vertex(rng);
+    G[u].emplace_back(u, vertex(rng), weight(rng));
+  }
+  return CSRGraph(G);
+}
+
+// 每个可达顶点的前驱边都必须是一条紧边
+static void expect_valid_tree(const CSRGraph& G, int source, const vector<int>& distance,
+                              const vector<int>& previous) {
+  ASSERT_EQ(distance[source], 0);
+  for (int v = 0; v < G.num_vertices(); ++v) {
+    if (v == source || distance[v] == INF) {
+      EXPECT_EQ(previous[v], -1);
+      continue;
+    }
+    int u = previous[v];
+    ASSERT_NE(u, -1);
+    bool tight = false;
+    for_each_edge(G, u, [&](int w, int weight) { tight |= w == v && distance[u] + weight == distance[v]; });
+    EXPECT_TRUE(tight) << "vertex " << v;
+  }
+}
+
+template <typename Queue>
+static void expect_queue_matches_default(const CSRGraph& G) {
+  for (int s = 0; s < G.num_vertices(); s += max(1, G.num_vertices() / 16)) {
+    vector<int> prev_default, prev_queue;
+    vector<int> expected = dijkstra_shortest_path(G, s, prev_default);
+    vector<int> actual = dijkstra_shortest_path<Queue>(G, s, prev_queue);
+    ASSERT_EQ(actual, expected) << "source " << s;
+    expect_valid_tree(G, s, actual, prev_queue);
+  }
+}
+
+TEST(PriorityQueues, AllEnginesMatchDefaultDijkstra) {
+  vector<CSRGraph> graphs;
+  for (const string name : {"small.txt", "medium.txt", "large.txt", "largest.txt"}) {
+    CSRGraph C;
+    file_to_graph(data_file(name), C);
+    graphs.push_back(C);
+  }
+  graphs.push_back(random_graph(2000, 10000, 100, 1));
+  graphs.push_back(random_graph(500, 8000, 3, 2));
+  graphs.push_back(random_graph(300, 600, 0, 3));
+
+  for (const CSRGraph& G : graphs) {
+    expect_queue_matches_default<LazyBinaryHeap>(G);
+    expect_queue_matches_default<DaryHeap<2>>(G);
+    expect_queue_matches_default<DaryHeap<4>>(G);
+    expect_queue_matches_default<RadixHeap>(G);
+    expect_queue_matches_default<DialQueue>(G);
+  }
+}
+
+TEST(PriorityQueues, DaryHeapDecreaseKey) {
+  DaryHeap<4> heap;
+  heap.reset(6);
+  for (int v = 0; v < 6; ++v)
+    heap.push(v, 100 - v);
+  heap.push(0, 1);
+  heap.push(5, 50);
+  EXPECT_EQ(heap.pop(), make_pair(0, 1));
+  EXPECT_EQ(heap.pop(), make_pair(5, 50));
+  EXPECT_EQ(heap.pop(), make_pair(4, 96));
+  heap.reset(6);
+  EXPECT_TRUE(heap.empty());
+  EXPECT_FALSE(heap.contains(3));
+}
+
+TEST(PriorityQueues, MonotoneQueuesRejectNegativeWeights) {
+  CSRGraph G;
+  parse_graph_text("2\n0 1 -1\n", G);
+  vector<int> previous;
+  EXPECT_THROW(dijkstra_shortest_path<RadixHeap>(G, 0, previous), runtime_error);
+  EXPECT_THROW(dijkstra_shortest_path<DialQueue>(G, 0, previous), runtime_error);
+}
+
+static int path_cost(const CSRGraph& G, const vector<int>& path) {
+  int cost = 0;
+  for (size_t i = 0; i + 1 < path.size(); ++i) {
+    int best = INF;
+    for_each_edge(G, path[i], [&](int v, int w) { if (v == path[i + 1]) best = min(best, w); });
+    if (best == INF)
+      return INF;
+    cost += best;
+  }
+  return cost;
+}
+
+static void expect_point_to_point_matches(const CSRGraph& G, PathQuery& query, const Heuristic& zero,
+                                          int s, int t, const vector<int>& distance) {
+  for (PathResult r : {query.early_exit(s, t), query.bidirectional(s, t), query.astar(s, t, zero)}) {
+    ASSERT_EQ(r.cost, distance[t]) << s << " -> " << t;
+    if (distance[t] == INF) {
+      EXPECT_TRUE(r.path.empty());
+      continue;
+    }
+    ASSERT_FALSE(r.path.empty());
+    EXPECT_EQ(r.path.front(), s);
+    EXPECT_EQ(r.path.back(), t);
+    EXPECT_EQ(path_cost(G, r.path), r.cost);
+  }
+}
+
+TEST(PointToPoint, AllModesMatchDijkstra) {
+  Heuristic zero = [](int) { return 0; };
+  for (const string name : {"small.txt", "medium.txt", "large.txt", "largest.txt"}) {
+    CSRGraph G;
+    file_to_graph(data_file(name), G);
+    PathQuery query(G);
+    for (int s = 0; s < G.num_vertices(); ++s) {
+      vector<int> previous;
+      vector<int> distance = dijkstra_shortest_path(G, s, previous);
+      for (int t = 0; t < G.num_vertices(); t += 3)
+        expect_point_to_point_matches(G, query, zero, s, t, distance);
+    }
+  }
+
+  CSRGraph G = random_graph(3000, 9000, 50, 4);
+  PathQuery query(G);
+  mt19937 rng(5);
+  uniform_int_distribution<int> vertex(0, G.num_vertices() - 1);
+  for (int i = 0; i < 20; ++i) {
+    int s = vertex(rng);
+    vector<int> previous;
+    vector<int> distance = dijkstra_shortest_path(G, s, previous);
+    for (int j = 0; j < 5; ++j)
+      expect_point_to_point_matches(G, query, zero, s, vertex(rng), distance);
+  }
+}
+
+TEST(PointToPoint, AStarWithCoordinates) {
+  // 网格图，边权不小于欧氏距离，因此欧氏启发函数可采纳
+  const int side = 30;
+  vector<Point> coords(side * side);
+  Graph grid;
+  grid.numVertices = side * side;
+  grid.resize(side * side);
+  mt19937 rng(6);
+  uniform_int_distribution<int> extra(0, 9);
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      int u = r * side + c;
+      coords[u] = {c * 10.0, r * 10.0};
+      if (c + 1 < side) {
+        grid[u].emplace_back(u, u + 1, 10 + extra(rng));
+        grid[u + 1].emplace_back(u + 1, u, 10 + extra(rng));
+      }
+      if (r + 1 < side) {
+        grid[u].emplace_back(u, u + side, 10 + extra(rng));
+        grid[u + side].emplace_back(u + side, u, 10 + extra(rng));
+      }
+    }
+  }
+  CSRGraph G(grid);
+  PathQuery query(G);
+  uniform_int_distribution<int> vertex(0, side * side - 1);
+  for (int i = 0; i < 50; ++i) {
+    int s = vertex(rng), t = vertex(rng);
+    vector<int> previous;
+    vector<int> distance = dijkstra_shortest_path(G, s, previous);
+    QueryOptions options{QueryMode::AStar, euclidean_heuristic(coords, t)};
+    PathResult r = query.run(s, t, options);
+    EXPECT_EQ(r.cost, distance[t]);
+    EXPECT_EQ(path_cost(G, r.path), r.cost);
+  }
+  EXPECT_EQ(shortest_path(grid, 0, side * side - 1, {QueryMode::Bidirectional, {}}).cost,
+            query.early_exit(0, side * side - 1).cost);
+}
+
+TEST(PointToPoint, SourceEqualsTargetAndUnreachable) {
+  CSRGraph G;
+  parse_graph_text("3\n0 1 4\n", G);
+  PathQuery query(G);
+  EXPECT_EQ(query.bidirectional(1, 1).path, vector<int>{1});
+  EXPECT_EQ(query.early_exit(2, 2).cost, 0);
+  EXPECT_EQ(query.bidirectional(1, 0).cost, INF);
+  EXPECT_TRUE(query.early_exit(0, 2).path.empty());
+  EXPECT_THROW(query.run(0, 1, {QueryMode::AStar, {}}), runtime_error);
+}
+
+TEST(PointToPoint, VertexOutOfRangeThrows) {
+  CSRGraph G;
+  parse_graph_text("3\n0 1 4\n1 2 1\n", G);
+  PathQuery query(G);
+  auto zero = [](int) { return 0; };
+  for (auto [s, t] : {pair{-1, 1}, pair{0, 3}, pair{3, 0}, pair{0, -5}}) {
+    EXPECT_THROW(query.early_exit(s, t), runtime_error) << s << " -> " << t;
+    EXPECT_THROW(query.bidirectional(s, t), runtime_error) << s << " -> " << t;
+    EXPECT_THROW(query.astar(s, t, zero), runtime_error) << s << " -> " << t;
+    EXPECT_THROW(shortest_path(G, s, t), runtime_error) << s << " -> " << t;
+  }
+  EXPECT_EQ(query.bidirectional(0, 2).cost, 5);
+
+  ContractionHierarchy ch = ContractionHierarchy::build(G);
+  CHQuery ch_query(ch);
+  EXPECT_THROW(ch_query.distance(0, 3), runtime_error);
+  EXPECT_THROW(ch_query.query(-1, 2), runtime_error);
+  EXPECT_EQ(ch_query.distance(0, 2), 5);
+}
+
+static void expect_ch_matches_dijkstra(const CSRGraph& G, const ContractionHierarchy& ch, int queries,
+                                       unsigned seed) {
+  CHQuery query(ch);
+  mt19937 rng(seed);
+  uniform_int_distribution<int> vertex(0, G.num_vertices() - 1);
+  for (int i = 0; i < queries; ++i) {
+    int s = vertex(rng), t = vertex(rng);
+    vector<int> previous;
+    vector<int> distance = dijkstra_shortest_path(G, s, previous);
+    PathResult r = query.query(s, t);
+    ASSERT_EQ(r.cost, distance[t]) << s << " -> " << t;
+    EXPECT_EQ(query.distance(s, t), distance[t]);
+    if (distance[t] == INF) {
+      EXPECT_TRUE(r.path.empty());
+      continue;
+    }
+    ASSERT_EQ(r.path.front(), s);
+    ASSERT_EQ(r.path.back(), t);
+    EXPECT_EQ(path_cost(G, r.path), distance[t]);
+  }
+}
+
+TEST(ContractionHierarchy, QueriesMatchDijkstra) {
+  for (const string name : {"small.txt", "medium.txt", "large.txt", "largest.txt"}) {
+    CSRGraph G;
+    file_to_graph(data_file(name), G);
+    expect_ch_matches_dijkstra(G, ContractionHierarchy::build(G), 200, 7);
+  }
+  CSRGraph sparse = random_graph(600, 1500, 100, 8);
+  expect_ch_matches_dijkstra(sparse, ContractionHierarchy::build(sparse), 150, 9);
+  CSRGraph zero = random_graph(300, 900, 2, 10);
+  expect_ch_matches_dijkstra(zero, ContractionHierarchy::build(zero, 5), 150, 11);
+}
+
+TEST(ContractionHierarchy, SaveAndLoad) {
+  CSRGraph G;
+  file_to_graph(data_file("largest.txt"), G);
+  ContractionHierarchy ch = ContractionHierarchy::build(G);
+  string file = testing::TempDir() + "largest.ch";
+  ch.save(file);
+  ContractionHierarchy loaded = ContractionHierarchy::load(file);
+  ASSERT_EQ(loaded.num_vertices(), ch.num_vertices());
+  ASSERT_EQ(loaded.num_arcs(), ch.num_arcs());
+  for (int v = 0; v < G.num_vertices(); ++v)
+    EXPECT_EQ(loaded.rank(v), ch.rank(v));
+  expect_ch_matches_dijkstra(G, loaded, 100, 12);
+  remove(file.c_str());
+  EXPECT_THROW(ContractionHierarchy::load(data_file("largest.txt")), runtime_error);
+}
+
+TEST(ContractionHierarchy, CorruptFileThrows) {
+  CSRGraph G;
+  file_to_graph(data_file("small.txt"), G);
+  ContractionHierarchy ch = ContractionHierarchy::build(G);
+  string file = testing::TempDir() + "corrupt.ch";
+  ch.save(file);
+  string bytes;
+  {
+    ifstream in(file, ios::binary);
+    bytes.assign(istreambuf_iterator<char>(in), {});
+  }
+  // 文件头 32 字节，之后是 ranks[n]、upOffsets[n + 1]、upArcs，每条边三个 int32
+  const size_t header = 32, n = G.num_vertices();
+  const size_t up_arcs = header + (2 * n + 1) * sizeof(int32_t);
+  ASSERT_GT(ch.up(0).size() + ch.up(1).size() + ch.up(2).size(), 0u);
+  auto expect_corrupt = [&](size_t offset, int value) {
+    string patched = bytes;
+    memcpy(&patched[offset], &value, sizeof(value));
+    ofstream(file, ios::binary) << patched;
+    EXPECT_THROW(ContractionHierarchy::load(file), runtime_error) << "offset " << offset;
+  };
+  expect_corrupt(header, ch.rank(1));                                 // rank 不是排列
+  expect_corrupt(header + (n + 1) * sizeof(int32_t), 99);            // upOffsets 不单调
+  expect_corrupt(up_arcs, static_cast<int>(n));                      // 端点越界
+  expect_corrupt(up_arcs + 2 * sizeof(int32_t), static_cast<int>(n)); // 中间顶点越界
+  // 第一条向上的边所在的顶点
+  int low = 0;
+  while (ch.up(low).empty())
+    ++low;
+  expect_corrupt(up_arcs + 2 * sizeof(int32_t), low);                // 中间顶点层次不低于端点，展开不会结束
+  remove(file.c_str());
+}
+
+TEST(Batch, TreesMatchSequentialDijkstra) {
+  CSRGraph G = random_graph(800, 4000, 30, 13);
+  vector<int> sources;
+  for (int s = 0; s < G.num_vertices(); s += 37)
+    sources.push_back(s);
+  sources.push_back(sources.front());
+
+  ThreadPool pool(4);
+  vector<ShortestPathTree> trees = batch_shortest_path_trees(G, sources, pool);
+  ASSERT_EQ(trees.size(), sources.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    vector<int> previous;
+    EXPECT_EQ(trees[i].source, sources[i]);
+    EXPECT_EQ(trees[i].distance, dijkstra_shortest_path(G, sources[i], previous));
+    expect_valid_tree(G, sources[i], trees[i].distance, trees[i].previous);
+  }
+  // 同一个线程池可以重复使用
+  EXPECT_EQ(batch_shortest_path_trees(G, sources, pool)[1].distance, trees[1].distance);
+}
+
+TEST(Batch, DistanceMatrix) {
+  CSRGraph G;
+  file_to_graph(data_file("largest.txt"), G);
+  vector<int> sources{0, 5, 17, 42, 99};
+  vector<int> targets{99, 0, 3, 3, 64};
+  vector<vector<int>> matrix = distance_matrix(G, sources, targets, 3);
+  ASSERT_EQ(matrix.size(), sources.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    vector<int> previous;
+    vector<int> distance = dijkstra_shortest_path(G, sources[i], previous);
+    for (size_t j = 0; j < targets.size(); ++j)
+      EXPECT_EQ(matrix[i][j], distance[targets[j]]);
+  }
+  EXPECT_THROW(distance_matrix(G, {100}, {0}, 1), runtime_error);
+  EXPECT_TRUE(distance_matrix(G, {}, {0}, 2).empty());
+}
+
+TEST(DeltaStepping, MatchesDijkstraForAnyDeltaAndThreadCount) {
+  vector<CSRGraph> graphs;
+  CSRGraph largest;
+  file_to_graph(data_file("largest.txt"), largest);
+  graphs.push_back(largest);
+  graphs.push_back(random_graph(5000, 40000, 100, 14));
+  graphs.push_back(random_graph(3000, 12000, 0, 15));
+
+  for (const CSRGraph& G : graphs) {
+    vector<int> expected_prev;
+    vector<int> expected = dijkstra_shortest_path(G, 0, expected_prev);
+    for (int threads : {1, 2, 4}) {
+      ThreadPool pool(threads);
+      for (int delta : {0, 1, 7, 50, 1000}) {
+        vector<int> previous;
+        vector<int> distance = delta_stepping_shortest_path(G, 0, previous, delta, pool);
+        ASSERT_EQ(distance, expected) << "threads " << threads << " delta " << delta;
+        expect_valid_tree(G, 0, distance, previous);
+      }
+    }
+  }
+}
+
+TEST(DeltaStepping, LargeWeightsWithUnitDelta) {
+  // delta = 1 时每个可能的距离都是一个桶；桶数有上限，空桶直接跳过
+  CSRGraph chain;
+  parse_graph_text("3\n0 1 1000000000\n1 2 1000000000\n0 2 2100000000\n", chain);
+  vector<int> previous;
+  EXPECT_EQ(delta_stepping_shortest_path(chain, 0, previous, 1, 1), (vector<int>{0, 1000000000, 2000000000}));
+  EXPECT_EQ(previous[2], 1);
+
+  CSRGraph G = random_graph(300, 6000, 500000000, 17);
+  vector<int> expected_prev;
+  vector<int> expected = dijkstra_shortest_path(G, 0, expected_prev);
+  // 最短距离加一条边也不会溢出
+  for (int d : expected)
+    ASSERT_TRUE(d == INF || d < INF - 500000000);
+  for (int threads : {1, 4}) {
+    vector<int> distance = delta_stepping_shortest_path(G, 0, previous, 1, threads);
+    ASSERT_EQ(distance, expected) << "threads " << threads;
+    expect_valid_tree(G, 0, distance, previous);
+  }
+}
+
+TEST(DeltaStepping, PathsWorkWithExtractShortestPath) {
+  CSRGraph G;
+  file_to_graph(data_file("small.txt"), G);
+  vector<int> previous;
+  vector<int> distance = delta_stepping_shortest_path(G, 0, previous, 2, 2);
+  EXPECT_EQ(extract_shortest_path(distance, previous, 2), (vector<int>{0, 3, 1, 2}));
+  EXPECT_THROW(delta_stepping_shortest_path(G, 4, previous), runtime_error);
+}
+
+static void expect_matches_recompute(const DynamicSSSP& dyn) {
+  CSRGraph G(dyn.graph());
+  vector<int> previous;
+  ASSERT_EQ(dyn.distance(), dijkstra_shortest_path(G, dyn.source(), previous));
+  expect_valid_tree(G, dyn.source(), dyn.distance(), dyn.previous());
+}
+
+TEST(DynamicSSSP, RandomUpdatesMatchFullRecompute) {
+  Graph G;
+  const int n = 300;
+  G.numVertices = n;
+  G.resize(n);
+  mt19937 rng(16);
+  uniform_int_distribution<int> vertex(0, n - 1), weight(0, 40), op(0, 3);
+  for (int i = 0; i < 1200; ++i) {
+    int u = vertex(rng);
+    G[u].emplace_back(u, vertex(rng), weight(rng));
+  }
+
+  DynamicSSSP dyn(G, 0);
+  expect_matches_recompute(dyn);
+  for (int step = 0; step < 400; ++step) {
+    Graph current = dyn.graph();
+    int u = vertex(rng);
+    int kind = current[u].empty() ? 2 : op(rng);
+    if (kind == 2) {
+      dyn.insert_edge(u, vertex(rng), weight(rng));
+    } else {
+      // 优先修改树边，这样删除和增大权重会真正触发子树修复
+      int v = current[u][uniform_int_distribution<size_t>(0, current[u].size() - 1)(rng)].dst;
+      for (const Edge& e : current[u])
+        if (dyn.previous()[e.dst] == u)
+          v = e.dst;
+      if (kind == 3)
+        dyn.delete_edge(u, v);
+      else
+        dyn.set_edge_weight(u, v, weight(rng));
+    }
+    expect_matches_recompute(dyn);
+  }
+}
+
+TEST(DynamicSSSP, TreeEdgeDeletionReroutes) {
+  CSRGraph G;
+  file_to_graph(data_file("small.txt"), G);
+  DynamicSSSP dyn(G, 0);
+  EXPECT_EQ(extract_shortest_path(dyn.distance(), dyn.previous(), 2), (vector<int>{0, 3, 1, 2}));
+  dyn.delete_edge(3, 1);
+  EXPECT_EQ(dyn.distance()[1], INF);
+  EXPECT_EQ(dyn.distance()[2], INF);
+  dyn.insert_edge(0, 1, 10);
+  EXPECT_EQ(dyn.distance()[2], 13);
+  dyn.set_edge_weight(0, 1, 1);
+  EXPECT_EQ(extract_shortest_path(dyn.distance(), dyn.previous(), 2), (vector<int>{0, 1, 2}));
+  EXPECT_THROW(dyn.delete_edge(2, 1), runtime_error);
+  EXPECT_THROW(dyn.set_edge_weight(0, 1, -1), runtime_error);
+}
+
+TEST(TreeExport, ExplicitSourceHandlesZeroWeightEdges) {
+  CSRGraph G;
+  parse_graph_text("4\n0 1 0\n1 2 0\n2 3 5\n", G);
+  ShortestPathTree tree;
+  tree.source = 0;
+  tree.distance = dijkstra_shortest_path(G, 0, tree.previous);
+  EXPECT_EQ(tree.path_to(3), (vector<int>{0, 1, 2, 3}));
+  EXPECT_EQ(extract_shortest_path(tree.distance, tree.previous, 3), (vector<int>{0, 1, 2, 3}));
+  EXPECT_EQ(tree.path_to(0), vector<int>{0});
+}
+
+TEST(TreeExport, PathsFormatMatchesPrintPath) {
+  CSRGraph G;
+  file_to_graph(data_file("medium.txt"), G);
+  ShortestPathTree tree;
+  tree.source = 2;
+  tree.distance = dijkstra_shortest_path(G, 2, tree.previous);
+
+  stringstream expected;
+  streambuf* saved = cout.rdbuf(expected.rdbuf());
+  for (int v = 0; v < G.num_vertices(); ++v) {
+    cout << "\nShortest path from 2 to " << v << ":" << endl;
+    print_path(extract_shortest_path(tree.distance, tree.previous, v), tree.distance[v]);
+  }
+  cout.rdbuf(saved);
+
+  stringstream actual;
+  export_shortest_path_tree(actual, tree, TreeFormat::Paths);
+  EXPECT_EQ(actual.str(), expected.str());
+}
+
+TEST(TreeExport, TextCsvAndBinary) {
+  CSRGraph G;
+  parse_graph_text("3\n0 1 4\n", G);
+  ShortestPathTree tree;
+  tree.source = 0;
+  tree.distance = dijkstra_shortest_path(G, 0, tree.previous);
+
+  stringstream text, csv, binary;
+  export_shortest_path_tree(text, tree, TreeFormat::Text);
+  export_shortest_path_tree(csv, tree, parse_tree_format("csv"));
+  export_shortest_path_tree(binary, tree, TreeFormat::Binary);
+  EXPECT_EQ(text.str(), "0 0 -1\n1 4 0\n2 inf -1\n");
+  EXPECT_EQ(csv.str(), "vertex,distance,previous\n0,0,-1\n1,4,0\n2,inf,-1\n");
+
+  string bytes = binary.str();
+  ASSERT_EQ(bytes.size(), sizeof(TreeFileHeader) + 6 * sizeof(int));
+  TreeFileHeader header;
+  memcpy(&header, bytes.data(), sizeof(header));
+  EXPECT_EQ(string(header.magic, 4), "HW9T");
+  EXPECT_EQ(header.numVertices, 3);
+  vector<int> arrays(6);
+  memcpy(arrays.data(), bytes.data() + sizeof(header), 6 * sizeof(int));
+  EXPECT_EQ(arrays, (vector<int>{0, 4, INF, -1, 0, -1}));
+  EXPECT_THROW(parse_tree_format("xml"), runtime_error);
+}
+
+TEST(GraphGen, SizesWeightsAndTextRoundTrip) {
+  Graph random = generate_random_graph(50, 200, 9, 3);
+  Graph grid = generate_grid_graph(4, 5, 9, 3);
+  Graph power = generate_power_law_graph(100, 300, 9, 3);
+  EXPECT_EQ(random.numVertices, 50);
+  EXPECT_EQ(grid.numVertices, 20);
+  EXPECT_EQ(power.numVertices, 100);
+  EXPECT_EQ(CSRGraph(random).num_edges(), 200);
+  EXPECT_EQ(CSRGraph(grid).num_edges(), 2 * (4 * 4 + 3 * 5));
+
+  for (const Graph* G : {&random, &grid, &power}) {
+    for (const auto& edges : *G)
+      for (const Edge& e : edges) {
+        EXPECT_GE(e.weight, 1);
+        EXPECT_LE(e.weight, 9);
+      }
+    stringstream text;
+    write_graph_text(text, *G);
+    CSRGraph parsed;
+    parse_graph_text(text.str(), parsed);
+    expect_same_graph(parsed, CSRGraph(*G));
+  }
+  stringstream a, b;
+  write_graph_text(a, generate_power_law_graph(100, 300, 9, 3));
+  write_graph_text(b, power);
+  EXPECT_EQ(a.str(), b.str());
+}
+
+TEST(Dictionary, LookupAndLexicographicIds) {
+  vector<string> words{"pear", "apple", "fig", "apple", "banana"};
+  Dictionary dict = Dictionary::from(words);
+  ASSERT_EQ(dict.size(), 4);
+  EXPECT_EQ(dict.word(0), "apple");
+  EXPECT_EQ(dict.word(3), "pear");
+  for (int id = 0; id < dict.size(); ++id)
+    EXPECT_EQ(dict.find(dict.word(id)), id);
+  EXPECT_EQ(dict.find("grape"), -1);
+  EXPECT_EQ(dict.find(""), -1);
+  EXPECT_FALSE(Dictionary().contains("apple"));
+}
+
+TEST(Dictionary, LoadWordsMatchesSet) {
+  set<string> words;
+  load_words(words, data_file("words.txt"));
+  Dictionary dict;
+  load_words(dict, data_file("words.txt"));
+  ASSERT_EQ(dict.size(), static_cast<int>(words.size()));
+  int id = 0;
+  for (const string& w : words)
+    EXPECT_EQ(dict.word(id++), w);
+  EXPECT_THROW(load_words(dict, data_file("missing.txt")), runtime_error);
+}
+
+TEST(Ladder, DictionaryMatchesSetOverload) {
+  set<string> words;
+  load_words(words, data_file("words.txt"));
+  Dictionary dict = Dictionary::from(words);
+  EXPECT_EQ(generate_word_ladder("cat", "dog", dict), (vector<string>{"cat", "cot", "cog", "dog"}));
+  EXPECT_EQ(generate_word_ladder("Car", "cheat", dict), (vector<string>{"car", "cat", "chat", "cheat"}));
+  EXPECT_EQ(generate_word_ladder("cqt", "cat", dict), (vector<string>{"cqt", "cat"}));
+  EXPECT_TRUE(generate_word_ladder("zzzq", "cat", dict).empty());
+  EXPECT_TRUE(generate_word_ladder("cat", "cat", dict).empty());
+  EXPECT_TRUE(generate_word_ladder("cat", "qqqq", dict).empty());
+  for (auto [a, b] : vector<pair<string, string>>{{"code", "data"}, {"work", "play"}, {"marty", "curls"}})
+    EXPECT_EQ(generate_word_ladder(a, b, dict), generate_word_ladder(a, b, words));
+}
+
+static vector<string> neighbor_words(const WordIndex& index, const string& w) {
+  vector<string> out;
+  for (int v : index.graph.neighbors(index.dictionary.find(w)))
+    out.emplace_back(index.dictionary.word(v));
+  return out;
+}
+
+TEST(WordIndex, AdjacencyFollowsProbeRules) {
+  vector<string> words{"cat", "cot", "coat", "at", "c-t", "dog"};
+  WordIndex index = build_word_index(Dictionary::from(words));
+  EXPECT_EQ(neighbor_words(index, "cat"), (vector<string>{"at", "coat", "cot"}));
+  // 替换和插入只产生字母，所以 "c-t" 只有出边
+  EXPECT_EQ(neighbor_words(index, "c-t"), (vector<string>{"cat", "cot"}));
+  EXPECT_EQ(neighbor_words(index, "at"), (vector<string>{"cat"}));
+  EXPECT_TRUE(neighbor_words(index, "dog").empty());
+}
+
+TEST(WordIndex, LaddersMatchProbingSearch) {
+  Dictionary dict;
+  load_words(dict, data_file("words.txt"));
+  WordIndex index = build_word_index(dict);
+  for (auto [a, b] : vector<pair<string, string>>{{"cat", "dog"}, {"code", "data"}, {"work", "play"},
+                                                  {"car", "cheat"}, {"cqt", "cat"}, {"o'brien", "brie"},
+                                                  {"cat", "cat"}, {"cat", "qqqq"}})
+    EXPECT_EQ(generate_word_ladder(a, b, index), generate_word_ladder(a, b, dict)) << a << " -> " << b;
+}
+
+TEST(WordTrie, NeighborsMatchWordGraph) {
+  Dictionary dict;
+  load_words(dict, data_file("words.txt"));
+  WordIndex index = build_word_index(dict);
+  WordTrie trie(dict);
+  auto sorted_unique = [](vector<int> ids) {
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+  };
+  for (int id = 0; id < dict.size(); id += 7) {
+    string_view w = dict.word(id);
+    ASSERT_EQ(trie.find(w), id);
+    vector<int> succ, pred;
+    trie.for_each_successor(w, [&](int v) { succ.push_back(v); });
+    trie.for_each_predecessor(w, [&](int v) { pred.push_back(v); });
+    auto out = index.graph.neighbors(id), in = index.graph.predecessors(id);
+    EXPECT_EQ(sorted_unique(succ), sorted_unique(vector<int>(out.begin(), out.end()))) << w;
+    EXPECT_EQ(sorted_unique(pred), sorted_unique(vector<int>(in.begin(), in.end()))) << w;
+  }
+  EXPECT_EQ(trie.find("cqt"), -1);
+  EXPECT_EQ(trie.find(""), -1);
+  for (auto [a, b] : vector<pair<string, string>>{{"cat", "dog"}, {"work", "play"}, {"cqt", "cat"}, {"o'brien", "brie"}})
+    EXPECT_EQ(generate_word_ladder(a, b, trie), generate_word_ladder(a, b, index)) << a << " -> " << b;
+
+  // 不在词典中的单词也能沿树枚举
+  vector<string> words{"cat", "cot", "coat", "at", "c-t", "dog"};
+  WordTrie small(Dictionary::from(words));
+  vector<string> found;
+  small.for_each_successor("c-g", [&](int v) { found.emplace_back(small.dictionary().word(v)); });
+  // 替换只产生字母："c-g" 能变成 "c-t"，"cxt" 却变不成 "c-t"
+  EXPECT_EQ(found, (vector<string>{"c-t"}));
+  found.clear();
+  small.for_each_successor("cxt", [&](int v) { found.emplace_back(small.dictionary().word(v)); });
+  sort(found.begin(), found.end());
+  EXPECT_EQ(found, (vector<string>{"cat", "cot"}));
+  EXPECT_EQ(generate_word_ladder("cxt", "coat", small), (vector<string>{"cxt", "cat", "coat"}));
+}
+
+TEST(WordIndex, SaveLoadAndCache) {
+  string dir = testing::TempDir();
+  string words_file = dir + "ladder_words.txt";
+  {
+    ofstream out(words_file);
+    out << "Cat\ncot\ncog\ndog\n\nCOAT \n";
+  }
+  string cache = word_index_cache_path(words_file);
+  remove(cache.c_str());
+
+  // 默认不写缓存
+  WordIndex built;
+  load_word_index_cached(words_file, built);
+  ASSERT_EQ(built.dictionary.size(), 5);
+  EXPECT_THROW(load_word_index(cache, built), runtime_error);
+  EXPECT_FALSE(load_fresh_word_index(words_file, built));
+  load_word_index_cached(words_file, built, true);
+  // 临时文件已经改名成缓存，没有留下
+  for (const auto& entry : filesystem::directory_iterator(dir))
+    EXPECT_NE(entry.path().filename().string().rfind("ladder_words.txt.idx.", 0), 0u) << entry.path();
+  WordIndex mapped;
+  load_word_index(cache, mapped);
+  ASSERT_EQ(mapped.dictionary.size(), 5);
+  for (int id = 0; id < 5; ++id) {
+    EXPECT_EQ(mapped.dictionary.word(id), built.dictionary.word(id));
+    EXPECT_EQ(mapped.dictionary.find(built.dictionary.word(id)), id);
+    EXPECT_TRUE(ranges::equal(mapped.graph.neighbors(id), built.graph.neighbors(id)));
+  }
+  EXPECT_TRUE(ranges::equal(mapped.components.labels_array(), built.components.labels_array()));
+  EXPECT_TRUE(ranges::equal(mapped.components.bounds_array(), built.components.bounds_array()));
+  EXPECT_EQ(generate_word_ladder("cat", "dog", mapped), (vector<string>{"cat", "cot", "cog", "dog"}));
+
+  WordIndex cached;
+  ASSERT_TRUE(load_fresh_word_index(words_file, cached));
+  EXPECT_EQ(cached.graph.num_edges(), built.graph.num_edges());
+  load_word_index_cached(words_file, cached, true);
+  EXPECT_EQ(cached.graph.num_edges(), built.graph.num_edges());
+  EXPECT_THROW(load_word_index(words_file, mapped), runtime_error);
+  remove(cache.c_str());
+  remove(words_file.c_str());
+}
+
+TEST(WordComponents, RejectionAndBoundsAgreeWithSearch) {
+  Dictionary dict;
+  load_words(dict, data_file("words.txt"));
+  WordIndex index = build_word_index(dict);
+  WordTrie trie(dict);
+  const WordComponents& components = index.components;
+  ASSERT_EQ(components.num_words(), dict.size());
+
+  mt19937 rng(17);
+  uniform_int_distribution<int> word(0, dict.size() - 1);
+  vector<pair<string, string>> pairs{{"cqt", "dog"}, {"cat", "o'brien"}, {"o'brien", "brie"}, {"zzzq", "cat"}};
+  for (int i = 0; i < 60; ++i)
+    pairs.emplace_back(dict.word(word(rng)), dict.word(word(rng)));
+  for (auto& [a, b] : pairs) {
+    // 不连通时直接返回，结果必须与完整搜索相同
+    vector<string> ladder = generate_word_ladder(a, b, index);
+    EXPECT_EQ(ladder, generate_word_ladder(a, b, trie)) << a << " -> " << b;
+    int u = dict.find(a), v = dict.find(b);
+    if (u < 0 || v < 0 || u == v)
+      continue;
+    if (!components.may_reach(u, v)) {
+      EXPECT_TRUE(ladder.empty()) << a << " -> " << b;
+    }
+    if (components.component(u) == components.component(v)) {
+      EXPECT_FALSE(ladder.empty()) << a << " -> " << b;
+      EXPECT_LE(static_cast<int>(ladder.size()) - 1, components.distance_bound(u, v)) << a << " -> " << b;
+    }
+  }
+}
+
+TEST(WordComponents, SmallDictionaryLevelsAndMismatch) {
+  vector<string> words{"c-t", "cat", "cog", "cot", "dog", "emu"};
+  WordIndex index = build_word_index(Dictionary::from(words));
+  const WordComponents& components = index.components;
+  EXPECT_EQ(components.num_components(), 3);
+  // cat 到 dog 需要 3 步
+  int c = components.component(1);
+  EXPECT_EQ(components.component_size(c), 4);
+  EXPECT_EQ(components.depth_bound(c), 3);
+  // 层级不同的单词之间只有单向边，不合并
+  EXPECT_NE(components.component(0), c);
+  EXPECT_TRUE(components.may_reach(0, 1));
+  EXPECT_FALSE(components.may_reach(1, 0));
+  EXPECT_FALSE(components.may_reach(1, 5));
+  // 不在词典中的起点取后继中最小的上界
+  EXPECT_EQ(generate_word_ladder("dot", "cat", index), (vector<string>{"dot", "cot", "cat"}));
+  EXPECT_TRUE(generate_word_ladder("cmu", "dog", index).empty());
+
+  // 连通分量与词典不一致时报错，而不是悄悄跳过判断
+  index.components = WordComponents();
+  EXPECT_THROW(generate_word_ladder("cat", "dog", index), runtime_error);
+}
+
+TEST(WordComponents, AddWordMatchesBatchLabeling) {
+  vector<string> words{"cat", "cot", "dog"};
+  WordComponents small(Dictionary::from(words), WordGraph::build(Dictionary::from(words)));
+  EXPECT_EQ(small.num_components(), 2);
+  EXPECT_EQ(small.depth_bound(small.component(0)), 1);
+  // "cog" 连接 cot 和 dog，插入后编号为 cat cog cot dog：cat 到 dog 需要 3 步
+  vector<int> cog_neighbors{2, 3};
+  int c = small.add_word(1, "cog", cog_neighbors);
+  EXPECT_EQ(small.num_components(), 1);
+  EXPECT_EQ(small.component(0), c);
+  EXPECT_EQ(small.component(1), c);
+  EXPECT_EQ(small.component_size(c), 4);
+  EXPECT_EQ(small.depth_bound(c), 3);
+  // 层级不同的单词之间只有单向边，不合并
+  vector<int> cat_neighbor{1};
+  small.add_word(0, "c-t", cat_neighbor);
+  EXPECT_EQ(small.num_components(), 2);
+  EXPECT_TRUE(small.may_reach(0, 1));
+  EXPECT_FALSE(small.may_reach(1, 0));
+  EXPECT_THROW(small.add_word(6, "cut", cat_neighbor), runtime_error);
+
+  // 按 ID 顺序逐个追加整个词典，分量划分与一次性计算的相同
+  Dictionary dict;
+  load_words(dict, data_file("words.txt"));
+  WordIndex index = build_word_index(dict);
+  WordComponents incremental;
+  vector<int> adjacent;
+  for (int id = 0; id < dict.size(); ++id) {
+    adjacent.clear();
+    for (span<const int> ids : {index.graph.neighbors(id), index.graph.predecessors(id)})
+      for (int v : ids)
+        if (v < id)
+          adjacent.push_back(v);
+    incremental.add_word(id, dict.word(id), adjacent);
+  }
+  const WordComponents& batch = index.components;
+  ASSERT_EQ(incremental.num_components(), batch.num_components());
+  vector<int> mapping(dict.size(), -1);
+  for (int id = 0; id < dict.size(); ++id) {
+    int b = batch.component(id), c = incremental.component(id);
+    if (mapping[b] < 0)
+      mapping[b] = c;
+    ASSERT_EQ(mapping[b], c) << dict.word(id);
+    EXPECT_EQ(incremental.component_size(c), batch.component_size(b));
+    EXPECT_EQ(incremental.level(c), batch.level(b));
+    EXPECT_LT(incremental.depth_bound(c), incremental.component_size(c));
+  }
+}
+
+TEST(WordIndex, AddWordMatchesRebuild) {
+  Dictionary full;
+  load_words(full, data_file("words.txt"));
+  // 抽出一部分单词（包括首尾和含非字母字符的），先建剩下的索引，再按随机顺序逐个加回
+  vector<string> kept, added{string(full.word(0)), "cog", "home-brew", "l'vov", string(full.word(full.size() - 1))};
+  for (int id = 0; id < full.size(); ++id) {
+    string w(full.word(id));
+    if (id % 4999 == 0 || find(added.begin(), added.end(), w) != added.end()) {
+      if (find(added.begin(), added.end(), w) == added.end())
+        added.push_back(w);
+    } else {
+      kept.push_back(w);
+    }
+  }
+  mt19937 rng(7);
+  shuffle(added.begin(), added.end(), rng);
+  WordIndex index = build_word_index(Dictionary::from(kept));
+  for (const string& w : added) {
+    int id = add_word(index, w);
+    ASSERT_EQ(index.dictionary.word(id), w);
+  }
+  EXPECT_EQ(add_word(index, "CAT"), index.dictionary.find("cat"));
+
+  WordIndex rebuilt = build_word_index(full);
+  ASSERT_EQ(index.dictionary.size(), full.size());
+  EXPECT_TRUE(ranges::equal(index.dictionary.arena_array(), full.arena_array()));
+  EXPECT_TRUE(ranges::equal(index.graph.offsets_array(), rebuilt.graph.offsets_array()));
+  EXPECT_TRUE(ranges::equal(index.graph.targets_array(), rebuilt.graph.targets_array()));
+  EXPECT_TRUE(ranges::equal(index.graph.sources_array(), rebuilt.graph.sources_array()));
+
+  // 分量划分与重建的相同；增量的上界可能更松，但仍然是最短梯子的上界
+  const WordComponents& incremental = index.components;
+  const WordComponents& batch = rebuilt.components;
+  ASSERT_EQ(incremental.num_components(), batch.num_components());
+  vector<int> mapping(full.size(), -1);
+  for (int id = 0; id < full.size(); ++id) {
+    int b = batch.component(id), c = incremental.component(id);
+    if (mapping[b] < 0)
+      mapping[b] = c;
+    ASSERT_EQ(mapping[b], c) << full.word(id);
+    EXPECT_EQ(incremental.component_size(c), batch.component_size(b));
+    EXPECT_EQ(incremental.level(c), batch.level(b));
+    EXPECT_LT(incremental.depth_bound(c), incremental.component_size(c));
+  }
+  uniform_int_distribution<int> word(0, full.size() - 1);
+  for (int i = 0; i < 40; ++i) {
+    int u = word(rng), v = word(rng);
+    string a(full.word(u)), b(full.word(v));
+    vector<string> ladder = generate_word_ladder(a, b, index);
+    EXPECT_EQ(ladder, generate_word_ladder(a, b, rebuilt)) << a << " -> " << b;
+    if (u != v && incremental.component(u) == incremental.component(v)) {
+      EXPECT_LE(static_cast<int>(ladder.size()) - 1, incremental.distance_bound(u, v)) << a << " -> " << b;
+    }
+  }
+  EXPECT_EQ(generate_word_ladder("cat", "dog", index), generate_word_ladder("cat", "dog", rebuilt));
+}
+
+TEST(Ladder, NoDepthLimitAndReusedState) {
+  Dictionary dict;
+  load_words(dict, data_file("words.txt"));
+  WordIndex index = build_word_index(dict);
+  vector<string> expected{"eze", "ere", "erie", "brie", "brig", "bring", "baring", "bearing", "hearing",
+                          "healing", "heeling", "reeling", "reveling", "revealing", "repealing", "repeating",
+                          "repenting", "resenting", "resetting", "resettings"};
+  EXPECT_EQ(generate_word_ladder("eze", "resettings", dict), expected);
+
+  LadderSearchState state;
+  for (int round = 0; round < 2; ++round) {
+    EXPECT_EQ(generate_word_ladder("eze", "resettings", index, state), expected);
+    EXPECT_EQ(generate_word_ladder("cat", "dog", index, state), (vector<string>{"cat", "cot", "cog", "dog"}));
+    EXPECT_TRUE(generate_word_ladder("cat", "o'brien", index, state).empty());
+  }
+}
+
+static int reference_edit_distance(const string& a, const string& b) {
+  vector<vector<int>> dp(a.size() + 1, vector<int>(b.size() + 1));
+  for (size_t i = 0; i <= a.size(); i++)
+    dp[i][0] = i;
+  for (size_t j = 0; j <= b.size(); j++)
+    dp[0][j] = j;
+  for (size_t i = 1; i <= a.size(); i++)
+    for (size_t j = 1; j <= b.size(); j++)
+      dp[i][j] = tolower(a[i - 1]) == tolower(b[j - 1]) ? dp[i - 1][j - 1]
+                                                        : 1 + min({dp[i - 1][j], dp[i][j - 1], dp[i - 1][j - 1]});
+  return dp[a.size()][b.size()];
+}
+
+// 小字母表让随机串之间的距离分布在各个 d 附近
+static string random_word(mt19937& rng, int max_length) {
+  uniform_int_distribution<int> length(0, max_length), letter(0, 3);
+  string w(length(rng), 'a');
+  for (char& c : w)
+    c = "abAc"[letter(rng)];
+  return w;
+}
+
+TEST(EditDistance, BoundedKernelMatchesReference) {
+  mt19937 rng(42);
+  for (int trial = 0; trial < 1200; ++trial) {
+    int max_length = trial % 3 == 0 ? 150 : 12;
+    string a = random_word(rng, max_length), b = random_word(rng, max_length);
+    if (trial % 4 == 0) {
+      b = a;
+      if (!b.empty())
+        b[rng() % b.size()] = 'c';
+    }
+    int exact = reference_edit_distance(a, b);
+    for (int d : {-1, 0, 1, 2, 3, 8, 9, 20, 70, 200}) {
+      EXPECT_EQ(bounded_edit_distance(a, b, d), d < 0 ? 0 : min(exact, d + 1)) << a << " " << b << " " << d;
+      EXPECT_EQ(edit_distance_within(a, b, d), exact <= d);
+    }
+  }
+  EXPECT_TRUE(is_adjacent("Cat", "cAt"));
+  EXPECT_TRUE(is_adjacent("cat", "chat"));
+  EXPECT_FALSE(is_adjacent("cat", "dog"));
+}
+
+TEST(EditDistance, BatchMatchesScalar) {
+  mt19937 rng(7);
+  vector<string> words;
+  for (int i = 0; i < 203; ++i)
+    words.push_back(random_word(rng, 20));
+  vector<string_view> views(words.begin(), words.end());
+  vector<uint8_t> out(views.size());
+  for (int trial = 0; trial < 20; ++trial) {
+    string word = random_word(rng, trial == 0 ? 0 : 20);
+    for (int d : {0, 1, 2, 3, 5}) {
+      edit_distance_within_batch(word, views, d, out);
+      for (size_t i = 0; i < words.size(); ++i)
+        ASSERT_EQ(out[i] != 0, reference_edit_distance(word, words[i]) <= d) << word << " " << words[i] << " " << d;
+    }
+  }
+
+  Dictionary dict = Dictionary::from(vector<string>{"cart", "cat", "chat", "coat", "dog", "scat"});
+  vector<int> near = find_within_distance(dict, "cat", 1);
+  vector<string> found;
+  for (int id : near)
+    found.emplace_back(dict.word(id));
+  EXPECT_EQ(found, (vector<string>{"cart", "cat", "chat", "coat", "scat"}));
+}
+
+TEST(LadderBatch, ParallelAnswersMatchSequentialInInputOrder) {
+  Dictionary dict;
+  load_words(dict, data_file("words.txt"));
+  WordIndex index = build_word_index(dict);
+  vector<pair<string, string>> queries{{"cat", "dog"}, {"code", "data"}, {"cat", "cat"}, {"work", "play"},
+                                       {"car", "cheat"}, {"cat", "qqqq"}, {"sleep", "awake"}, {"eze", "resettings"}};
+  stringstream in, expected;
+  for (const auto& [a, b] : queries) {
+    in << a << " " << b << "\n";
+    BufferedWriter writer(expected);
+    write_word_ladder(writer, generate_word_ladder(a, b, index));
+  }
+  in << "leftover";
+
+  for (int threads : {1, 3}) {
+    ThreadPool pool(threads);
+    vector<vector<string>> ladders = batch_word_ladders(index, queries, pool);
+    ASSERT_EQ(ladders.size(), queries.size());
+    for (size_t i = 0; i < queries.size(); ++i)
+      EXPECT_EQ(ladders[i], generate_word_ladder(queries[i].first, queries[i].second, index));
+
+    stringstream input(in.str()), out;
+    EXPECT_EQ(answer_ladder_queries(index, input, out, pool, 3), static_cast<long long>(queries.size()));
+    EXPECT_EQ(out.str(), expected.str());
+  }
+}
+
+TEST(Stats, CountersFollowSearchesAcrossThreads) {
+  if (!stats::enabled)
+    GTEST_SKIP() << "built without HW9_STATS";
+  stats::reset();
+  CSRGraph G;
+  file_to_graph(data_file("small.txt"), G);
+  vector<int> previous;
+  dijkstra_shortest_path(G, 0, previous);
+  stats::Snapshot s = stats::snapshot();
+  EXPECT_EQ(s[stats::Timer::FileToGraph].calls, 1u);
+  EXPECT_EQ(s[stats::Timer::DijkstraSearch].calls, 1u);
+  EXPECT_EQ(s[stats::Counter::DijkstraPushes], s[stats::Counter::DijkstraPops]);
+  // 四个顶点都可达，每个恰好确定一次、扫描一次出边
+  EXPECT_EQ(s[stats::Counter::DijkstraPops] - s[stats::Counter::DijkstraStalePops], 4u);
+  EXPECT_EQ(s[stats::Counter::DijkstraRelaxations], static_cast<uint64_t>(G.num_edges()));
+  // 点对点查询同样计数
+  stats::reset();
+  EXPECT_EQ(shortest_path(G, 0, 2, {QueryMode::Bidirectional, {}}).cost, 6);
+  s = stats::snapshot();
+  EXPECT_EQ(s[stats::Timer::DijkstraSearch].calls, 1u);
+  EXPECT_GT(s[stats::Counter::DijkstraPops], 0u);
+  EXPECT_GE(s[stats::Counter::DijkstraPushes], s[stats::Counter::DijkstraPops]);
+
+  vector<string> words{"cat", "cot", "cog", "dog", "emu"};
+  WordIndex index = build_word_index(Dictionary::from(words));
+  stats::reset();
+  EXPECT_EQ(generate_word_ladder("cat", "dog", index).size(), 4u);
+  EXPECT_TRUE(generate_word_ladder("cat", "emu", index).empty());
+  s = stats::snapshot();
+  EXPECT_EQ(s[stats::Timer::LadderSearch].calls, 2u);
+  EXPECT_EQ(s[stats::Counter::LadderWordsCopied], 4u);
+  EXPECT_EQ(s[stats::Counter::LadderRejected], 1u);
+  EXPECT_EQ(s[stats::Counter::LadderProbes], 0u);
+  EXPECT_GE(s[stats::Counter::LadderCandidates], s[stats::Counter::LadderVisitedHits]);
+  generate_word_ladder("cat", "dog", WordTrie(index.dictionary));
+  uint64_t trie_probes = stats::snapshot()[stats::Counter::LadderProbes];
+  EXPECT_GT(trie_probes, 0u);
+  // 逐个试探的计数在搜索结束时一次汇总
+  generate_word_ladder("cat", "dog", index.dictionary);
+  EXPECT_GT(stats::snapshot()[stats::Counter::LadderProbes], trie_probes);
+
+  // 工作线程的计数在每次查询结束时汇总
+  vector<pair<string, string>> queries{{"cat", "dog"}, {"dog", "cat"}, {"cot", "dog"}, {"cog", "emu"}, {"emu", "cat"}};
+  stats::reset();
+  ThreadPool pool(3);
+  uint64_t copied = 0;
+  for (const vector<string>& ladder : batch_word_ladders(index, queries, pool))
+    copied += ladder.size();
+  s = stats::snapshot();
+  EXPECT_EQ(s[stats::Timer::LadderSearch].calls, queries.size());
+  EXPECT_EQ(s[stats::Counter::LadderWordsCopied], copied);
+  EXPECT_EQ(s[stats::Counter::LadderRejected], 2u);
 
-TEST(Replace, Me) {
-  EXPECT_TRUE(false);
+  ostringstream json;
+  stats::write_json(json);
+  EXPECT_EQ(json.str().rfind("{\"enabled\": true, \"counters\": {\"dijkstra_pushes\": 0", 0), 0u);
+  EXPECT_NE(json.str().find("\"ladder_search\": {\"calls\": 5, \"total_ms\": "), string::npos);
 }
@@ -0,0 +1,89 @@
+#include "batch.h"
+
+namespace {
+
+// 在工作区中运行 Dijkstra；remaining 为 0 时停止，is_target 为空表示搜索整张图
+void run_dijkstra(const CSRGraph& G, int source, SearchSpace& ws, const vector<char>& is_target, int remaining) {
+    ws.start(G.num_vertices());
+    ws.update(source, 0, -1);
+    ws.heap.push(source, 0);
+    while (!ws.heap.empty()) {
+        auto [u, du] = ws.heap.pop();
+        ws.settle(u);
+        if (!is_target.empty() && is_target[u] && --remaining == 0)
+            return;
+        for_each_edge(G, u, [&](int v, int w) {
+            if (!ws.settled(v) && du + w < ws.dist(v)) {
+                ws.update(v, du + w, u);
+                ws.heap.push(v, du + w);
+            }
+        });
+    }
+}
+
+void check_sources(const CSRGraph& G, const vector<int>& vertices) {
+    for (int v : vertices)
+        if (v < 0 || v >= G.num_vertices())
+            throw runtime_error("Vertex out of range");
+}
+
+}
+
+vector<ShortestPathTree> batch_shortest_path_trees(const CSRGraph& G, const vector<int>& sources, ThreadPool& pool) {
+    check_sources(G, sources);
+    int n = G.num_vertices();
+    vector<ShortestPathTree> trees(sources.size());
+    vector<SearchSpace> workspaces(pool.size());
+    const vector<char> all;
+
+    pool.run(static_cast<int>(sources.size()), [&](int task, int worker) {
+        SearchSpace& ws = workspaces[worker];
+        run_dijkstra(G, sources[task], ws, all, 0);
+        ShortestPathTree& tree = trees[task];
+        tree.source = sources[task];
+        tree.distance.resize(n);
+        tree.previous.resize(n);
+        for (int v = 0; v < n; ++v) {
+            tree.distance[v] = ws.dist(v);
+            tree.previous[v] = ws.prev(v);
+        }
+    });
+    return trees;
+}
+
+vector<ShortestPathTree> batch_shortest_path_trees(const CSRGraph& G, const vector<int>& sources, int threads) {
+    ThreadPool pool(threads);
+    return batch_shortest_path_trees(G, sources, pool);
+}
+
+vector<vector<int>> distance_matrix(const CSRGraph& G, const vector<int>& sources, const vector<int>& targets,
+                                    ThreadPool& pool) {
+    check_sources(G, sources);
+    check_sources(G, targets);
+    vector<char> is_target(G.num_vertices(), 0);
+    int distinct = 0;
+    for (int t : targets)
+        if (!is_target[t]) {
+            is_target[t] = 1;
+            ++distinct;
+        }
+
+    vector<vector<int>> matrix(sources.size(), vector<int>(targets.size(), INF));
+    vector<SearchSpace> workspaces(pool.size());
+    if (distinct == 0)
+        return matrix;
+
+    pool.run(static_cast<int>(sources.size()), [&](int task, int worker) {
+        SearchSpace& ws = workspaces[worker];
+        run_dijkstra(G, sources[task], ws, is_target, distinct);
+        for (size_t j = 0; j < targets.size(); ++j)
+            matrix[task][j] = ws.dist(targets[j]);
+    });
+    return matrix;
+}
+
+vector<vector<int>> distance_matrix(const CSRGraph& G, const vector<int>& sources, const vector<int>& targets,
+                                    int threads) {
+    ThreadPool pool(threads);
+    return distance_matrix(G, sources, targets, pool);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "dijkstras.h"
+#include "search_space.h"
+#include "thread_pool.h"
+
+// 多源批量最短路径。每个源点是线程池中的一个任务；每个线程持有自己的 SearchSpace，
+// 在任务之间只递增 epoch 而不重新分配或填充 INF
+
+// 每个源点一棵完整的最短路径树，顺序与 sources 相同
+vector<ShortestPathTree> batch_shortest_path_trees(const CSRGraph& G, const vector<int>& sources, ThreadPool& pool);
+vector<ShortestPathTree> batch_shortest_path_trees(const CSRGraph& G, const vector<int>& sources, int threads = 0);
+
+// matrix[i][j] 是 sources[i] 到 targets[j] 的距离（不可达为 INF）；
+// 每个源点的搜索在所有目标都确定后提前结束
+vector<vector<int>> distance_matrix(const CSRGraph& G, const vector<int>& sources, const vector<int>& targets,
+                                    ThreadPool& pool);
+vector<vector<int>> distance_matrix(const CSRGraph& G, const vector<int>& sources, const vector<int>& targets,
+                                    int threads = 0);
@@ -0,0 +1,408 @@
+#include "dijkstras.h"
+#include "graph_io.h"
+#include "graph_gen.h"
+#include "shortest_path.h"
+#include "contraction.h"
+#include "batch.h"
+#include "delta_stepping.h"
+#include "ladder.h"
+#include "ladder_batch.h"
+
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <sys/resource.h>
+
+// bench_main generate <random|grid|powerlaw> <vertices> <edges> <max_weight> <seed> <out.txt>
+//   生成合成图（grid 的 vertices 取整为正方形，edges 被忽略）
+// bench_main [选项]
+//   --graph FILE          使用已有的图文件，否则按下面的参数生成
+//   --kind K --vertices N --edges M --max-weight W --seed S（默认 grid，10000 个顶点）
+//   --queries Q           每项测试的查询数
+//   --threads T           并行测试的最大线程数（1, 2, 4, ... , T）
+//   --words FILE          词典文件，默认 words.txt；文件不存在时跳过单词梯子测试
+//   --skip-ch             跳过收缩层次（在大的随机图上预处理很慢）
+// 结果以 JSON 写到标准输出，便于在不同版本之间比较
+
+namespace {
+
+using Clock = chrono::steady_clock;
+
+struct Options {
+    string graph;
+    string kind = "grid";
+    int vertices = 10000;
+    int edges = 40000;
+    int maxWeight = 100;
+    unsigned seed = 1;
+    int queries = 20;
+    int threads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    string words = "words.txt";
+    bool skipCH = false;
+};
+
+// 整个进程的峰值内存（ru_maxrss 只增不减），所以只在报告末尾输出一次，不能归到某一项测试
+long peak_rss_kb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+string json_string(const string& s) {
+    string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+class Report {
+public:
+    using Fields = vector<pair<string, string>>;
+
+    void config(const string& key, const string& json_value) { configFields.emplace_back(key, json_value); }
+
+    // 记录一组逐次测得的延迟（微秒），输出次数、吞吐量和延迟分位数
+    void add(const string& group, const string& name, vector<double> micros, Fields extra = {}) {
+        sort(micros.begin(), micros.end());
+        double total = 0;
+        for (double m : micros)
+            total += m;
+        auto percentile = [&](double p) {
+            return micros.empty() ? 0.0 : micros[min(micros.size() - 1, static_cast<size_t>(p * micros.size()))];
+        };
+        Fields f{{"group", json_string(group)},
+                 {"name", json_string(name)},
+                 {"count", to_string(micros.size())},
+                 {"total_ms", number(total / 1000)},
+                 {"throughput_per_s", number(total > 0 ? micros.size() * 1e6 / total : 0)},
+                 {"p50_us", number(percentile(0.50))},
+                 {"p90_us", number(percentile(0.90))},
+                 {"p99_us", number(percentile(0.99))},
+                 {"max_us", number(micros.empty() ? 0 : micros.back())}};
+        f.insert(f.end(), extra.begin(), extra.end());
+        results.push_back(std::move(f));
+        cerr << group << "/" << name << ": " << micros.size() << " runs, p50 " << percentile(0.5) << " us" << endl;
+    }
+
+    void print(ostream& out) const {
+        out << "{\n  \"config\": {";
+        for (size_t i = 0; i < configFields.size(); ++i)
+            out << (i ? ", " : "") << json_string(configFields[i].first) << ": " << configFields[i].second;
+        out << "},\n  \"results\": [\n";
+        for (size_t r = 0; r < results.size(); ++r) {
+            out << "    {";
+            for (size_t i = 0; i < results[r].size(); ++i)
+                out << (i ? ", " : "") << json_string(results[r][i].first) << ": " << results[r][i].second;
+            out << "}" << (r + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n  \"peak_rss_kb\": " << peak_rss_kb() << "\n}\n";
+    }
+
+    static string number(double v) {
+        ostringstream s;
+        s.precision(6);
+        s << v;
+        return s.str();
+    }
+
+private:
+    Fields configFields;
+    vector<Fields> results;
+};
+
+// 防止被测调用的结果被优化掉
+volatile long long sink = 0;
+
+void keep(long long value) {
+    sink = sink + value;
+}
+
+template <typename F>
+vector<double> measure(int iterations, F&& f) {
+    vector<double> micros;
+    micros.reserve(iterations);
+    for (int i = 0; i < iterations; ++i) {
+        auto start = Clock::now();
+        f(i);
+        micros.push_back(chrono::duration<double, micro>(Clock::now() - start).count());
+    }
+    return micros;
+}
+
+Graph make_graph(const string& kind, int vertices, int edges, int max_weight, unsigned seed) {
+    if (kind == "random")
+        return generate_random_graph(vertices, edges, max_weight, seed);
+    if (kind == "grid") {
+        int side = max(1, static_cast<int>(sqrt(static_cast<double>(vertices))));
+        return generate_grid_graph(side, side, max_weight, seed);
+    }
+    if (kind == "powerlaw")
+        return generate_power_law_graph(vertices, edges, max_weight, seed);
+    throw runtime_error("Unknown graph kind: " + kind);
+}
+
+vector<int> thread_counts(int max_threads) {
+    vector<int> counts;
+    for (int t = 1; t < max_threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(max_threads);
+    return counts;
+}
+
+template <typename Queue>
+void bench_queue(Report& report, const string& name, const CSRGraph& G, const vector<int>& sources) {
+    auto micros = measure(static_cast<int>(sources.size()), [&](int i) {
+        vector<int> previous;
+        keep(dijkstra_shortest_path<Queue>(G, sources[i], previous)[0]);
+    });
+    report.add("sssp", name, micros, {{"edges", to_string(G.num_edges())}});
+}
+
+void bench_graph(Report& report, const Options& opt) {
+    namespace fs = std::filesystem;
+    string text_file = opt.graph;
+    fs::path scratch = fs::temp_directory_path() / ("hw9_bench_" + to_string(::getpid()));
+    if (text_file.empty()) {
+        Graph generated = make_graph(opt.kind, opt.vertices, opt.edges, opt.maxWeight, opt.seed);
+        text_file = scratch.string() + ".txt";
+        ofstream out(text_file);
+        write_graph_text(out, generated);
+    }
+    string binary_file = scratch.string() + ".bin";
+
+    CSRGraph G;
+    report.add("load", "file_to_graph_adjacency", measure(3, [&](int) {
+        Graph list;
+        file_to_graph(text_file, list);
+        keep(list.numVertices);
+    }));
+    report.add("load", "file_to_graph_csr", measure(3, [&](int) { file_to_graph(text_file, G); }));
+    save_graph_binary(binary_file, G);
+    report.add("load", "load_graph_binary", measure(3, [&](int) {
+        CSRGraph mapped;
+        load_graph_binary(binary_file, mapped);
+        keep(mapped.num_edges());
+    }));
+    report.config("vertices", to_string(G.num_vertices()));
+    report.config("edges", to_string(G.num_edges()));
+
+    mt19937 rng(opt.seed);
+    uniform_int_distribution<int> vertex(0, G.num_vertices() - 1);
+    vector<int> sources(opt.queries), targets(opt.queries);
+    for (int i = 0; i < opt.queries; ++i) {
+        sources[i] = vertex(rng);
+        targets[i] = vertex(rng);
+    }
+
+    Graph list;
+    file_to_graph(text_file, list);
+    report.add("sssp", "dijkstra_adjacency", measure(opt.queries, [&](int i) {
+        vector<int> previous;
+        keep(dijkstra_shortest_path(list, sources[i], previous)[0]);
+    }));
+    bench_queue<LazyBinaryHeap>(report, "dijkstra_csr_lazy_binary", G, sources);
+    bench_queue<DaryHeap<2>>(report, "dijkstra_csr_dary2", G, sources);
+    bench_queue<DaryHeap<4>>(report, "dijkstra_csr_dary4", G, sources);
+    bench_queue<RadixHeap>(report, "dijkstra_csr_radix", G, sources);
+    bench_queue<DialQueue>(report, "dijkstra_csr_dial", G, sources);
+
+    // 从 1 到 T 个线程的扩展性
+    int delta = default_delta(G);
+    for (int threads : thread_counts(opt.threads)) {
+        ThreadPool pool(threads);
+        report.add("sssp", "delta_stepping", measure(opt.queries, [&](int i) {
+            vector<int> previous;
+            keep(delta_stepping_shortest_path(G, sources[i], previous, delta, pool)[0]);
+        }), {{"threads", to_string(threads)}, {"delta", to_string(delta)}});
+        report.add("batch", "distance_matrix", measure(1, [&](int) {
+            keep(distance_matrix(G, sources, targets, pool)[0][0]);
+        }), {{"threads", to_string(threads)}, {"cells", to_string(sources.size() * targets.size())}});
+    }
+
+    PathQuery query(G);
+    report.add("p2p", "early_exit", measure(opt.queries, [&](int i) { keep(query.early_exit(sources[i], targets[i]).cost); }));
+    report.add("p2p", "bidirectional", measure(opt.queries, [&](int i) { keep(query.bidirectional(sources[i], targets[i]).cost); }));
+    if (opt.graph.empty() && opt.kind == "grid") {
+        int side = max(1, static_cast<int>(sqrt(static_cast<double>(opt.vertices))));
+        vector<Point> coords(G.num_vertices());
+        for (int v = 0; v < G.num_vertices(); ++v)
+            coords[v] = {static_cast<double>(v % side), static_cast<double>(v / side)};
+        report.add("p2p", "astar_euclidean", measure(opt.queries, [&](int i) {
+            keep(query.astar(sources[i], targets[i], euclidean_heuristic(coords, targets[i])).cost);
+        }));
+    }
+
+    if (!opt.skipCH) {
+        ContractionHierarchy ch;
+        auto micros = measure(1, [&](int) { ch = ContractionHierarchy::build(G); });
+        report.add("ch", "build", micros, {{"arcs", to_string(ch.num_arcs())}});
+        CHQuery ch_query(ch);
+        report.add("ch", "query", measure(opt.queries, [&](int i) { keep(ch_query.query(sources[i], targets[i]).cost); }));
+    }
+
+    if (opt.graph.empty())
+        fs::remove(text_file);
+    fs::remove(binary_file);
+}
+
+// 固定的查询集：作业说明中的示例加上按种子从词典中抽取的短词对
+vector<pair<string, string>> ladder_queries(const set<string>& words, int count, unsigned seed) {
+    vector<pair<string, string>> queries{{"cat", "dog"}, {"code", "data"}, {"work", "play"},
+                                         {"sleep", "awake"}, {"car", "cheat"}, {"marty", "curls"}};
+    vector<string> short_words;
+    for (const string& w : words)
+        if (w.size() >= 3 && w.size() <= 4)
+            short_words.push_back(w);
+    mt19937 rng(seed);
+    uniform_int_distribution<size_t> pick(0, short_words.empty() ? 0 : short_words.size() - 1);
+    while (static_cast<int>(queries.size()) < count && !short_words.empty())
+        queries.emplace_back(short_words[pick(rng)], short_words[pick(rng)]);
+    queries.resize(min<size_t>(queries.size(), count));
+    return queries;
+}
+
+void bench_ladder(Report& report, const Options& opt) {
+    if (!ifstream(opt.words)) {
+        report.config("ladder_skipped", json_string("dictionary " + opt.words + " not found"));
+        return;
+    }
+    // 先测量再填附加字段：函数实参的求值顺序不确定
+    set<string> words;
+    auto micros = measure(3, [&](int) {
+        words.clear();
+        load_words(words, opt.words);
+    });
+    report.add("ladder", "load_words_set", micros, {{"words", to_string(words.size())}});
+    Dictionary dictionary;
+    micros = measure(3, [&](int) { load_words(dictionary, opt.words); });
+    report.add("ladder", "load_words_dictionary", micros, {{"words", to_string(dictionary.size())}});
+
+    auto queries = ladder_queries(words, opt.queries, opt.seed);
+    long long total_length = 0;
+    micros = measure(static_cast<int>(queries.size()), [&](int i) {
+        total_length += generate_word_ladder(queries[i].first, queries[i].second, words).size();
+    });
+    report.add("ladder", "generate_word_ladder_set", micros, {{"total_ladder_length", to_string(total_length)}});
+    total_length = 0;
+    micros = measure(static_cast<int>(queries.size()), [&](int i) {
+        total_length += generate_word_ladder(queries[i].first, queries[i].second, dictionary).size();
+    });
+    report.add("ladder", "generate_word_ladder", micros, {{"total_ladder_length", to_string(total_length)}});
+
+    WordTrie trie;
+    micros = measure(3, [&](int) { trie = WordTrie(dictionary); });
+    report.add("ladder", "build_word_trie", micros, {{"nodes", to_string(trie.num_nodes())}});
+    total_length = 0;
+    micros = measure(static_cast<int>(queries.size()), [&](int i) {
+        total_length += generate_word_ladder(queries[i].first, queries[i].second, trie).size();
+    });
+    report.add("ladder", "generate_word_ladder_trie", micros, {{"total_ladder_length", to_string(total_length)}});
+
+    WordIndex index;
+    micros = measure(1, [&](int) { index = build_word_index(dictionary); });
+    report.add("ladder", "build_word_index", micros, {{"edges", to_string(index.graph.num_edges())},
+                                                      {"components", to_string(index.components.num_components())}});
+    string index_file = (std::filesystem::temp_directory_path() / ("hw9_bench_" + to_string(::getpid()) + ".idx")).string();
+    save_word_index(index_file, index);
+    report.add("ladder", "load_word_index_mmap", measure(3, [&](int) {
+        WordIndex mapped;
+        load_word_index(index_file, mapped);
+        keep(mapped.graph.num_edges());
+    }));
+    std::filesystem::remove(index_file);
+    total_length = 0;
+    micros = measure(static_cast<int>(queries.size()), [&](int i) {
+        total_length += generate_word_ladder(queries[i].first, queries[i].second, index).size();
+    });
+    report.add("ladder", "generate_word_ladder_index", micros, {{"total_ladder_length", to_string(total_length)}});
+
+    // 批量查询在 1 到 T 个线程上的扩展性，查询集重复到足够多
+    vector<pair<string, string>> batch;
+    while (batch.size() < 2000)
+        batch.insert(batch.end(), queries.begin(), queries.end());
+    for (int threads : thread_counts(opt.threads)) {
+        ThreadPool pool(threads);
+        report.add("ladder", "batch_word_ladders", measure(1, [&](int) { keep(batch_word_ladders(index, batch, pool).size()); }),
+                   {{"threads", to_string(threads)}, {"queries", to_string(batch.size())}});
+    }
+
+    // 整个词典中与查询词编辑距离不超过 2 的单词
+    long long near_count = 0;
+    micros = measure(static_cast<int>(queries.size()), [&](int i) {
+        near_count += find_within_distance(dictionary, queries[i].first, 2).size();
+    });
+    report.add("ladder", "find_within_distance_2", micros, {{"matches", to_string(near_count)}});
+
+    // 一半命中一半不命中
+    vector<string> probes;
+    for (const auto& [a, b] : queries) {
+        probes.push_back(a);
+        probes.push_back(b + "x");
+    }
+    report.add("ladder", "lookup_set", measure(static_cast<int>(probes.size()), [&](int i) { keep(words.count(probes[i])); }));
+    report.add("ladder", "lookup_dictionary", measure(static_cast<int>(probes.size()), [&](int i) { keep(dictionary.find(probes[i])); }));
+}
+
+int generate_main(int argc, char* argv[]) {
+    if (argc != 8) {
+        cerr << "Usage: " << argv[0] << " generate <random|grid|powerlaw> <vertices> <edges> <max_weight> <seed> <out.txt>" << endl;
+        return 2;
+    }
+    Graph G = make_graph(argv[2], stoi(argv[3]), stoi(argv[4]), stoi(argv[5]), stoul(argv[6]));
+    ofstream out(argv[7]);
+    if (!out)
+        throw runtime_error("Can't open output file");
+    write_graph_text(out, G);
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc > 1 && string(argv[1]) == "generate")
+            return generate_main(argc, argv);
+
+        Options opt;
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            auto value = [&]() -> string {
+                if (i + 1 >= argc)
+                    throw runtime_error("Missing value for " + arg);
+                return argv[++i];
+            };
+            if (arg == "--graph") opt.graph = value();
+            else if (arg == "--kind") opt.kind = value();
+            else if (arg == "--vertices") opt.vertices = stoi(value());
+            else if (arg == "--edges") opt.edges = stoi(value());
+            else if (arg == "--max-weight") opt.maxWeight = stoi(value());
+            else if (arg == "--seed") opt.seed = stoul(value());
+            else if (arg == "--queries") opt.queries = max(1, stoi(value()));
+            else if (arg == "--threads") opt.threads = max(1, stoi(value()));
+            else if (arg == "--words") opt.words = value();
+            else if (arg == "--skip-ch") opt.skipCH = true;
+            else throw runtime_error("Unknown option " + arg);
+        }
+
+        Report report;
+        report.config("graph", json_string(opt.graph.empty() ? opt.kind : opt.graph));
+        report.config("seed", to_string(opt.seed));
+        report.config("queries", to_string(opt.queries));
+        report.config("max_threads", to_string(opt.threads));
+        bench_graph(report, opt);
+        bench_ladder(report, opt);
+        report.print(cout);
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <charconv>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// 先把输出攒进一大块缓冲区再整块写出，避免逐行 endl 刷新带来的系统调用
+class BufferedWriter {
+public:
+    explicit BufferedWriter(ostream& out, size_t capacity = 1 << 16) : out(out) { buffer.reserve(capacity); }
+    ~BufferedWriter() { flush(); }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    void put(char c) {
+        if (buffer.size() == buffer.capacity())
+            flush();
+        buffer.push_back(c);
+    }
+
+    void write(string_view s) {
+        if (buffer.size() + s.size() > buffer.capacity())
+            flush();
+        if (s.size() > buffer.capacity()) {
+            out.write(s.data(), s.size());
+            return;
+        }
+        buffer.insert(buffer.end(), s.begin(), s.end());
+    }
+
+    void write_int(long long value) {
+        char digits[24];
+        auto result = to_chars(digits, digits + sizeof(digits), value);
+        write(string_view(digits, result.ptr - digits));
+    }
+
+    void write_bytes(const void* data, size_t size) { write(string_view(static_cast<const char*>(data), size)); }
+
+    void flush() {
+        if (!buffer.empty()) {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+private:
+    ostream& out;
+    vector<char> buffer;
+};
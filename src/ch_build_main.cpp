@@ -0,0 +1,20 @@
+#include "contraction.h"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        cerr << "Usage: " << argv[0] << " <graph.txt|graph.bin> <output.ch>" << endl;
+        return 2;
+    }
+    try {
+        CSRGraph G;
+        file_to_graph(argv[1], G);
+        ContractionHierarchy ch = ContractionHierarchy::build(G);
+        ch.save(argv[2]);
+        cout << "Contracted " << ch.num_vertices() << " vertices into " << ch.num_arcs()
+             << " arcs (" << G.num_edges() << " original edges)" << endl;
+    } catch (const runtime_error& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,367 @@
+#include "contraction.h"
+#include "graph_io.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+// 预处理期间的动态图：只保存尚未收缩的顶点之间的边，每对顶点之间最多一条
+class Contractor {
+public:
+    Contractor(const CSRGraph& G, int settle_limit)
+        : n(G.num_vertices()), settleLimit(settle_limit), out(n), in(n), contracted(n, 0), deletedNeighbors(n, 0),
+          up(n), down(n), ranks(n, -1) {
+        for (int u = 0; u < n; ++u)
+            for_each_edge(G, u, [&](int v, int w) {
+                if (u != v)
+                    add_arc(u, v, w, -1);
+            });
+    }
+
+    void run() {
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> order;
+        for (int v = 0; v < n; ++v)
+            order.emplace(priority(v), v);
+
+        // 惰性更新：弹出的顶点重新计算优先级，若不再是最小值则放回
+        int next_rank = 0;
+        while (!order.empty()) {
+            int v = order.top().second;
+            order.pop();
+            if (contracted[v])
+                continue;
+            int p = priority(v);
+            if (!order.empty() && p > order.top().first) {
+                order.emplace(p, v);
+                continue;
+            }
+            contract(v);
+            ranks[v] = next_rank++;
+        }
+    }
+
+    int n;
+    int settleLimit;
+    vector<vector<CHArc>> out;
+    vector<vector<CHArc>> in;
+    vector<char> contracted;
+    vector<int> deletedNeighbors;
+    vector<vector<CHArc>> up;
+    vector<vector<CHArc>> down;
+    vector<int> ranks;
+
+private:
+    void add_arc(int u, int x, int w, int mid) {
+        for (CHArc& a : out[u]) {
+            if (a.node == x) {
+                if (w < a.weight) {
+                    a.weight = w;
+                    a.mid = mid;
+                    for (CHArc& b : in[x])
+                        if (b.node == u) {
+                            b.weight = w;
+                            b.mid = mid;
+                        }
+                }
+                return;
+            }
+        }
+        out[u].push_back({x, w, mid});
+        in[x].push_back({u, w, mid});
+    }
+
+    // 从 u 出发、不经过 v 的受限 Dijkstra；之后 witness.dist(x) 是一条不经过 v 的路径长度上界
+    void witness_search(int u, int v, int max_cost) {
+        witness.start(n);
+        witness.update(u, 0, -1);
+        witness.heap.push(u, 0);
+        int settled = 0;
+        while (!witness.heap.empty()) {
+            auto [x, d] = witness.heap.pop();
+            if (d > max_cost || ++settled > settleLimit)
+                break;
+            witness.settle(x);
+            for (const CHArc& a : out[x]) {
+                if (a.node == v || witness.settled(a.node) || d + a.weight >= witness.dist(a.node))
+                    continue;
+                witness.update(a.node, d + a.weight, x);
+                witness.heap.push(a.node, d + a.weight);
+            }
+        }
+    }
+
+    // 对收缩 v 所需的每条捷径 u -> x 调用 f(u, x, cost)
+    template <typename F>
+    void for_each_shortcut(int v, F&& f) {
+        for (const CHArc& in_arc : in[v]) {
+            int u = in_arc.node;
+            int max_cost = -1;
+            for (const CHArc& out_arc : out[v])
+                if (out_arc.node != u)
+                    max_cost = max(max_cost, in_arc.weight + out_arc.weight);
+            if (max_cost < 0)
+                continue;
+            witness_search(u, v, max_cost);
+            for (const CHArc& out_arc : out[v]) {
+                int cost = in_arc.weight + out_arc.weight;
+                if (out_arc.node != u && witness.dist(out_arc.node) > cost)
+                    f(u, out_arc.node, cost);
+            }
+        }
+    }
+
+    // 边差 (新增捷径数 - 删除的边数) 加上已收缩邻居数，使收缩在图中分布均匀
+    int priority(int v) {
+        int shortcuts = 0;
+        for_each_shortcut(v, [&](int, int, int) { ++shortcuts; });
+        return shortcuts - static_cast<int>(in[v].size() + out[v].size()) + deletedNeighbors[v];
+    }
+
+    void contract(int v) {
+        vector<tuple<int, int, int>> shortcuts;
+        for_each_shortcut(v, [&](int u, int x, int cost) { shortcuts.emplace_back(u, x, cost); });
+
+        up[v] = out[v];
+        down[v] = in[v];
+        contracted[v] = 1;
+        auto drop_v = [v](vector<CHArc>& arcs) {
+            arcs.erase(remove_if(arcs.begin(), arcs.end(), [v](const CHArc& a) { return a.node == v; }), arcs.end());
+        };
+        for (const CHArc& a : in[v]) {
+            drop_v(out[a.node]);
+            ++deletedNeighbors[a.node];
+        }
+        for (const CHArc& a : out[v]) {
+            drop_v(in[a.node]);
+            ++deletedNeighbors[a.node];
+        }
+        out[v].clear();
+        in[v].clear();
+
+        for (auto [u, x, cost] : shortcuts)
+            add_arc(u, x, cost, v);
+    }
+
+    SearchSpace witness;
+};
+
+void flatten(const vector<vector<CHArc>>& lists, vector<int>& offsets, vector<CHArc>& arcs) {
+    offsets.assign(lists.size() + 1, 0);
+    for (size_t v = 0; v < lists.size(); ++v)
+        offsets[v + 1] = offsets[v] + static_cast<int>(lists[v].size());
+    arcs.clear();
+    arcs.reserve(offsets.back());
+    for (const auto& list : lists)
+        arcs.insert(arcs.end(), list.begin(), list.end());
+}
+
+struct CHFileHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t numVertices;
+    int32_t reserved;
+    int64_t numUpArcs;
+    int64_t numDownArcs;
+};
+
+constexpr char CH_FILE_MAGIC[4] = {'H', 'W', '9', 'C'};
+constexpr uint32_t CH_FILE_VERSION = 1;
+
+}
+
+ContractionHierarchy ContractionHierarchy::build(const CSRGraph& G, int witness_settle_limit) {
+    Contractor c(G, witness_settle_limit);
+    c.run();
+
+    ContractionHierarchy ch;
+    ch.numVertices = G.num_vertices();
+    ch.ranks = std::move(c.ranks);
+    flatten(c.up, ch.upOffsets, ch.upArcs);
+    flatten(c.down, ch.downOffsets, ch.downArcs);
+    return ch;
+}
+
+const CHArc& ContractionHierarchy::find_arc(int from, int to) const {
+    if (ranks[from] < ranks[to]) {
+        for (const CHArc& a : up(from))
+            if (a.node == to)
+                return a;
+    } else {
+        for (const CHArc& a : down(to))
+            if (a.node == from)
+                return a;
+    }
+    throw runtime_error("Contraction hierarchy is missing an arc");
+}
+
+void ContractionHierarchy::unpack_arc(int from, int to, vector<int>& path) const {
+    vector<pair<int, int>> stack{{from, to}};
+    while (!stack.empty()) {
+        auto [a, b] = stack.back();
+        stack.pop_back();
+        const CHArc& arc = find_arc(a, b);
+        if (arc.mid == -1) {
+            path.push_back(b);
+        } else {
+            stack.emplace_back(arc.mid, b);
+            stack.emplace_back(a, arc.mid);
+        }
+    }
+}
+
+void ContractionHierarchy::save(const string& filename) const {
+    ofstream out(filename, ios::binary);
+    if (!out)
+        throw runtime_error("Can't open output file");
+
+    CHFileHeader header{};
+    memcpy(header.magic, CH_FILE_MAGIC, sizeof(header.magic));
+    header.version = CH_FILE_VERSION;
+    header.numVertices = numVertices;
+    header.numUpArcs = upArcs.size();
+    header.numDownArcs = downArcs.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    auto write_vector = [&](const auto& v) {
+        out.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(v[0]));
+    };
+    write_vector(ranks);
+    write_vector(upOffsets);
+    write_vector(upArcs);
+    write_vector(downOffsets);
+    write_vector(downArcs);
+    if (!out)
+        throw runtime_error("Failed to write contraction hierarchy");
+}
+
+ContractionHierarchy ContractionHierarchy::load(const string& filename) {
+    MappedFile file(filename);
+    CHFileHeader header;
+    if (file.size() < sizeof(header))
+        throw runtime_error("Truncated contraction hierarchy file");
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, CH_FILE_MAGIC, sizeof(header.magic)) != 0)
+        throw runtime_error("Not a contraction hierarchy file");
+    if (header.version != CH_FILE_VERSION)
+        throw runtime_error("Unsupported contraction hierarchy version");
+    if (header.numVertices < 0 || header.numUpArcs < 0 || header.numDownArcs < 0 || header.numUpArcs > INT_MAX
+        || header.numDownArcs > INT_MAX)
+        throw runtime_error("Malformed contraction hierarchy header");
+
+    size_t n = header.numVertices;
+    size_t expected = sizeof(header) + (n + 2 * (n + 1)) * sizeof(int32_t)
+        + (header.numUpArcs + header.numDownArcs) * sizeof(CHArc);
+    if (file.size() != expected)
+        throw runtime_error("Truncated contraction hierarchy file");
+
+    ContractionHierarchy ch;
+    ch.numVertices = header.numVertices;
+    const char* p = file.data() + sizeof(header);
+    auto read_vector = [&](auto& v, size_t count) {
+        v.resize(count);
+        memcpy(v.data(), p, count * sizeof(v[0]));
+        p += count * sizeof(v[0]);
+    };
+    read_vector(ch.ranks, n);
+    read_vector(ch.upOffsets, n + 1);
+    read_vector(ch.upArcs, header.numUpArcs);
+    read_vector(ch.downOffsets, n + 1);
+    read_vector(ch.downArcs, header.numDownArcs);
+    auto valid_offsets = [](const vector<int>& offsets, int64_t arcs) {
+        return offsets.front() == 0 && offsets.back() == arcs && is_sorted(offsets.begin(), offsets.end());
+    };
+    if (!valid_offsets(ch.upOffsets, header.numUpArcs) || !valid_offsets(ch.downOffsets, header.numDownArcs))
+        throw runtime_error("Malformed contraction hierarchy offsets");
+
+    // rank 必须是 0..n-1 的排列；每条边指向层次更高的顶点，捷径的中间顶点层次更低，
+    // 这样查询只会向上走，unpack_arc 每展开一层两端的层次都严格下降，一定会结束
+    vector<bool> seen(n, false);
+    for (int r : ch.ranks) {
+        if (r < 0 || r >= header.numVertices || seen[r])
+            throw runtime_error("Malformed contraction hierarchy ranks");
+        seen[r] = true;
+    }
+    for (int v = 0; v < header.numVertices; ++v) {
+        for (span<const CHArc> arcs : {ch.up(v), ch.down(v)}) {
+            for (const CHArc& a : arcs) {
+                if (a.node < 0 || a.node >= header.numVertices || ch.ranks[a.node] <= ch.ranks[v])
+                    throw runtime_error("Malformed contraction hierarchy arcs");
+                if (a.mid != -1 && (a.mid < 0 || a.mid >= header.numVertices || ch.ranks[a.mid] >= ch.ranks[v]))
+                    throw runtime_error("Malformed contraction hierarchy arcs");
+            }
+        }
+    }
+    return ch;
+}
+
+// 两个方向都只沿层次升高的边搜索；任一方向堆中的最小键都不小于当前最优值时停止
+int CHQuery::search(int source, int target, int& meet) {
+    int n = ch.num_vertices();
+    if (source < 0 || source >= n || target < 0 || target >= n)
+        throw runtime_error("Vertex out of range");
+    fwd.start(n);
+    bwd.start(n);
+    fwd.update(source, 0, -1);
+    fwd.heap.push(source, 0);
+    bwd.update(target, 0, -1);
+    bwd.heap.push(target, 0);
+
+    int best = INF;
+    meet = -1;
+    if (source == target) {
+        best = 0;
+        meet = source;
+    }
+
+    while (true) {
+        int fmin = fwd.heap.empty() ? INF : fwd.heap.min_key();
+        int bmin = bwd.heap.empty() ? INF : bwd.heap.min_key();
+        if (min(fmin, bmin) >= best)
+            break;
+        bool forward_step = fmin <= bmin;
+        SearchSpace& self = forward_step ? fwd : bwd;
+        SearchSpace& other = forward_step ? bwd : fwd;
+
+        auto [u, du] = self.heap.pop();
+        self.settle(u);
+        for (const CHArc& a : forward_step ? ch.up(u) : ch.down(u)) {
+            int v = a.node;
+            if (self.settled(v) || du + a.weight >= self.dist(v))
+                continue;
+            self.update(v, du + a.weight, u);
+            self.heap.push(v, du + a.weight);
+            if (other.is_reached(v) && static_cast<long long>(du) + a.weight + other.dist(v) < best) {
+                best = du + a.weight + other.dist(v);
+                meet = v;
+            }
+        }
+    }
+    return best;
+}
+
+int CHQuery::distance(int source, int target) {
+    int meet;
+    return search(source, target, meet);
+}
+
+PathResult CHQuery::query(int source, int target) {
+    int meet;
+    PathResult result;
+    result.cost = search(source, target, meet);
+    if (meet == -1)
+        return result;
+
+    vector<int> up_chain;
+    for (int at = meet; at != -1; at = fwd.prev(at))
+        up_chain.push_back(at);
+    reverse(up_chain.begin(), up_chain.end());
+
+    result.path.push_back(source);
+    for (size_t i = 0; i + 1 < up_chain.size(); ++i)
+        ch.unpack_arc(up_chain[i], up_chain[i + 1], result.path);
+    for (int at = meet; bwd.prev(at) != -1; at = bwd.prev(at))
+        ch.unpack_arc(at, bwd.prev(at), result.path);
+    return result;
+}
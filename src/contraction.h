@@ -0,0 +1,69 @@
+#pragma once
+
+#include "dijkstras.h"
+#include "search_space.h"
+#include "shortest_path.h"
+
+// 收缩层次 (contraction hierarchy)：按重要性依次收缩顶点，必要时加入捷径边。
+// 每条边只保存在其两端中较低层次的顶点上：
+//   up[v]   v -> w，rank[w] > rank[v]
+//   down[v] u -> v，rank[u] > rank[v]
+// 捷径边记录被收缩的中间顶点 mid（原始边为 -1），用于展开成原图中的路径
+struct CHArc {
+    int node;
+    int weight;
+    int mid;
+};
+
+class ContractionHierarchy {
+public:
+    ContractionHierarchy() = default;
+
+    // 离线预处理；witness_settle_limit 限制每次见证搜索确定的顶点数，
+    // 限制越小预处理越快但捷径边越多（结果始终正确）
+    static ContractionHierarchy build(const CSRGraph& G, int witness_settle_limit = 500);
+
+    int num_vertices() const { return numVertices; }
+    int num_arcs() const { return static_cast<int>(upArcs.size() + downArcs.size()); }
+    int rank(int v) const { return ranks[v]; }
+
+    span<const CHArc> up(int v) const {
+        return span<const CHArc>(upArcs).subspan(upOffsets[v], upOffsets[v + 1] - upOffsets[v]);
+    }
+    span<const CHArc> down(int v) const {
+        return span<const CHArc>(downArcs).subspan(downOffsets[v], downOffsets[v + 1] - downOffsets[v]);
+    }
+
+    // 把边 from -> to（层次结构中的一条边）展开为原图顶点序列，追加到 path（不含 from）
+    void unpack_arc(int from, int to, vector<int>& path) const;
+
+    void save(const string& filename) const;
+    static ContractionHierarchy load(const string& filename);
+
+private:
+    const CHArc& find_arc(int from, int to) const;
+
+    int numVertices = 0;
+    vector<int> ranks;
+    vector<int> upOffsets;
+    vector<CHArc> upArcs;
+    vector<int> downOffsets;
+    vector<CHArc> downArcs;
+};
+
+// 在收缩层次上做双向只向上的搜索；返回的距离与 dijkstra_shortest_path 相同，
+// 路径是展开后的原图路径（距离相等的路径之间可能选择不同）
+class CHQuery {
+public:
+    explicit CHQuery(const ContractionHierarchy& ch) : ch(ch) {}
+
+    int distance(int source, int target);
+    PathResult query(int source, int target);
+
+private:
+    int search(int source, int target, int& meet);
+
+    const ContractionHierarchy& ch;
+    SearchSpace fwd;
+    SearchSpace bwd;
+};
@@ -0,0 +1,185 @@
+#include "delta_stepping.h"
+
+#include <atomic>
+#include <cstdint>
+#include <queue>
+
+namespace {
+
+// 距离放在高 32 位、前驱放在低 32 位，一次 CAS 同时更新两者，保证前驱始终对应当前距离
+constexpr uint64_t pack(int dist, int prev) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(dist)) << 32) | static_cast<uint32_t>(prev);
+}
+constexpr int dist_of(uint64_t s) { return static_cast<int>(s >> 32); }
+constexpr int prev_of(uint64_t s) { return static_cast<int>(static_cast<uint32_t>(s)); }
+
+// 小于这个大小的前沿直接在调用线程上处理，避免线程同步的开销
+constexpr size_t PARALLEL_GRAIN = 512;
+
+// 循环使用的桶数上限：delta 太小而权重很大时把 delta 调大，否则每个可能的桶都要一个 vector
+constexpr int MAX_BUCKETS = 1 << 16;
+
+class DeltaStepping {
+public:
+    DeltaStepping(const CSRGraph& G, int delta, ThreadPool& pool)
+        : G(G), delta(delta), pool(pool), state(G.num_vertices()), frontierStamp(G.num_vertices(), 0),
+          phaseStamp(G.num_vertices(), 0), requests(pool.size()) {
+        int max_weight = 0;
+        for (int i = 0; i < G.num_edges(); ++i) {
+            if (G.edge_weight(i) < 0)
+                throw runtime_error("Delta-stepping requires non-negative weights");
+            max_weight = max(max_weight, G.edge_weight(i));
+        }
+        // 距离与 delta 无关，调大只是让每个桶内的轻边松弛轮数变多
+        this->delta = max(delta, (max_weight + MAX_BUCKETS - 1) / MAX_BUCKETS);
+        // 所有有效条目都落在 [当前桶, 当前桶 + max_weight / delta + 1] 内，因此桶可以循环使用
+        buckets.resize(max_weight / this->delta + 2);
+    }
+
+    void run(int source, vector<int>& distance, vector<int>& previous) {
+        for (auto& s : state)
+            s.store(pack(INF, -1), memory_order_relaxed);
+        state[source].store(pack(0, -1), memory_order_relaxed);
+        push(source);
+
+        // 直接跳到下一个非空的桶，而不是逐个扫过中间的空桶。
+        // 正在处理的桶被清空后又有条目入桶时，它的编号会再次入堆；这时它已经处理过了，跳过
+        long long last = -1;
+        while (!active.empty()) {
+            long long index = active.top();
+            active.pop();
+            vector<int>& bucket = slot(index);
+            if (index <= last || bucket.empty())
+                continue;
+            last = index;
+            ++phase;
+            settled.clear();
+            while (!bucket.empty()) {
+                frontier.clear();
+                frontier.swap(bucket);
+                ++round;
+                // 去掉重复条目以及距离已经降到其它桶的过期条目
+                size_t kept = 0;
+                for (int v : frontier) {
+                    if (dist_of(state[v].load(memory_order_relaxed)) / delta != index || frontierStamp[v] == round)
+                        continue;
+                    frontierStamp[v] = round;
+                    frontier[kept++] = v;
+                    if (phaseStamp[v] != phase) {
+                        phaseStamp[v] = phase;
+                        settled.push_back(v);
+                    }
+                }
+                frontier.resize(kept);
+                relax_all(frontier, true);
+            }
+            relax_all(settled, false);
+        }
+
+        int n = G.num_vertices();
+        distance.resize(n);
+        previous.resize(n);
+        for (int v = 0; v < n; ++v) {
+            uint64_t s = state[v].load(memory_order_relaxed);
+            distance[v] = dist_of(s);
+            previous[v] = prev_of(s);
+        }
+    }
+
+private:
+    vector<int>& slot(long long index) { return buckets[index % buckets.size()]; }
+
+    void push(int v) {
+        long long index = dist_of(state[v].load(memory_order_relaxed)) / delta;
+        vector<int>& bucket = slot(index);
+        if (bucket.empty())
+            active.push(index);
+        bucket.push_back(v);
+    }
+
+    bool relax(int v, int d, int u) {
+        uint64_t old = state[v].load(memory_order_relaxed);
+        while (dist_of(old) > d)
+            if (state[v].compare_exchange_weak(old, pack(d, u), memory_order_relaxed))
+                return true;
+        return false;
+    }
+
+    // 并行松弛 vertices 的轻边或重边，被改进的顶点先记在各线程自己的请求列表里，再统一入桶
+    void relax_all(const vector<int>& vertices, bool light) {
+        auto work = [&](size_t begin, size_t end, vector<int>& out) {
+            for (size_t i = begin; i < end; ++i) {
+                int u = vertices[i];
+                int du = dist_of(state[u].load(memory_order_relaxed));
+                for_each_edge(G, u, [&](int v, int w) {
+                    if ((w <= delta) == light && relax(v, du + w, u))
+                        out.push_back(v);
+                });
+            }
+        };
+
+        if (vertices.size() < PARALLEL_GRAIN || pool.size() == 1) {
+            work(0, vertices.size(), requests[0]);
+        } else {
+            size_t chunks = min(vertices.size() / (PARALLEL_GRAIN / 4), static_cast<size_t>(pool.size()) * 4);
+            pool.run(static_cast<int>(chunks), [&](int task, int worker) {
+                size_t begin = vertices.size() * task / chunks;
+                size_t end = vertices.size() * (task + 1) / chunks;
+                work(begin, end, requests[worker]);
+            });
+        }
+        for (auto& out : requests) {
+            for (int v : out)
+                push(v);
+            out.clear();
+        }
+    }
+
+    const CSRGraph& G;
+    int delta;
+    ThreadPool& pool;
+    vector<atomic<uint64_t>> state;
+    vector<vector<int>> buckets;
+    // 非空桶的编号，最小的在堆顶
+    priority_queue<long long, vector<long long>, greater<>> active;
+    vector<int> frontier;
+    vector<int> settled;
+    vector<uint32_t> frontierStamp;
+    vector<uint32_t> phaseStamp;
+    uint32_t round = 0;
+    uint32_t phase = 0;
+    vector<vector<int>> requests;
+};
+
+}
+
+int default_delta(const CSRGraph& G) {
+    if (G.num_edges() == 0)
+        return 1;
+    long long total = 0;
+    int max_weight = 0;
+    for (int i = 0; i < G.num_edges(); ++i) {
+        total += G.edge_weight(i);
+        max_weight = max(max_weight, G.edge_weight(i));
+    }
+    // 平均权重乘以 2 大致让每个桶内的轻边松弛轮数保持很少，同时避免桶过多
+    long long avg = total / G.num_edges();
+    return static_cast<int>(max(1LL, min<long long>(max_weight, 2 * avg)));
+}
+
+vector<int> delta_stepping_shortest_path(const CSRGraph& G, int source, vector<int>& previous, int delta,
+                                         ThreadPool& pool) {
+    if (source < 0 || source >= G.num_vertices())
+        throw runtime_error("Vertex out of range");
+    if (delta <= 0)
+        delta = default_delta(G);
+    vector<int> distance;
+    DeltaStepping(G, delta, pool).run(source, distance, previous);
+    return distance;
+}
+
+vector<int> delta_stepping_shortest_path(const CSRGraph& G, int source, vector<int>& previous, int delta,
+                                         int threads) {
+    ThreadPool pool(threads);
+    return delta_stepping_shortest_path(G, source, previous, delta, pool);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "dijkstras.h"
+#include "thread_pool.h"
+
+// 并行 delta-stepping 单源最短路径（Meyer & Sanders）。按距离把顶点分入宽度为 delta 的桶，
+// 每个桶内反复并行松弛轻边 (w <= delta)，桶清空后再一次性松弛重边。
+// 返回值与 previous 的含义和 dijkstra_shortest_path 相同，可直接交给 extract_shortest_path；
+// 距离完全一致，前驱只在等长路径之间可能不同。权重必须非负。
+// delta <= 0 时根据最大权重和平均出度自动选择；为了限制桶数，小于 最大权重 / 65536 的 delta 会被调大
+vector<int> delta_stepping_shortest_path(const CSRGraph& G, int source, vector<int>& previous, int delta,
+                                         ThreadPool& pool);
+vector<int> delta_stepping_shortest_path(const CSRGraph& G, int source, vector<int>& previous, int delta = 0,
+                                         int threads = 0);
+
+int default_delta(const CSRGraph& G);
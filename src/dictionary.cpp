@@ -0,0 +1,138 @@
+#include "dictionary.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+struct DictionaryStorage {
+    string arena;
+    vector<uint32_t> offsets;
+    vector<Dictionary::Slot> slots;
+};
+}
+
+Dictionary::Dictionary(vector<string_view> words) {
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+
+    auto owned = make_shared<DictionaryStorage>();
+    size_t total = 0;
+    for (string_view w : words)
+        total += w.size();
+    owned->arena.reserve(total);
+    owned->offsets.reserve(words.size() + 1);
+    owned->offsets.push_back(0);
+    for (string_view w : words) {
+        owned->arena.append(w);
+        owned->offsets.push_back(static_cast<uint32_t>(owned->arena.size()));
+    }
+    arena = owned->arena;
+    offsets = owned->offsets;
+
+    // 装载因子不超过 1/2
+    size_t capacity = 16;
+    while (capacity < 2 * words.size())
+        capacity *= 2;
+    owned->slots.assign(capacity, Slot{0, -1});
+    mask = static_cast<uint32_t>(capacity - 1);
+    for (int id = 0; id < size(); ++id) {
+        uint32_t h = hash_of(word(id));
+        uint32_t i = h & mask;
+        while (owned->slots[i].id >= 0)
+            i = (i + 1) & mask;
+        owned->slots[i] = Slot{h, id};
+    }
+    slots = owned->slots;
+    storage = std::move(owned);
+    collect_alphabet();
+}
+
+Dictionary::Dictionary(span<const char> arena, span<const uint32_t> offsets, span<const Slot> slots,
+                       shared_ptr<const void> owner)
+    : arena(arena), offsets(offsets), slots(slots), storage(std::move(owner)) {
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != arena.size()
+        || !is_sorted(offsets.begin(), offsets.end()))
+        throw runtime_error("Malformed dictionary arrays");
+    collect_alphabet();
+    if (slots.empty() && size() == 0)
+        return;
+    if (slots.size() < offsets.size() || (slots.size() & (slots.size() - 1)) != 0)
+        throw runtime_error("Malformed dictionary hash table");
+    // 每个 ID 都要在范围内，且至少留一个空槽，否则 find 可能越界或不停地探测
+    int n = size(), empty_slots = 0;
+    for (const Slot& s : slots) {
+        if (s.id < -1 || s.id >= n)
+            throw runtime_error("Malformed dictionary hash table");
+        empty_slots += s.id < 0;
+    }
+    if (empty_slots == 0)
+        throw runtime_error("Malformed dictionary hash table");
+    mask = static_cast<uint32_t>(slots.size() - 1);
+}
+
+void Dictionary::collect_alphabet() {
+    bool seen[256] = {};
+    for (char c : arena)
+        seen[static_cast<unsigned char>(c)] = true;
+    characters.clear();
+    for (int c = 0; c < 256; ++c)
+        if (seen[c])
+            characters += static_cast<char>(c);
+}
+
+uint32_t Dictionary::hash_of(string_view w) {
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (char c : w) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+int Dictionary::find(string_view w) const {
+    if (slots.empty())
+        return -1;
+    uint32_t h = hash_of(w);
+    for (uint32_t i = h & mask;; i = (i + 1) & mask) {
+        const Slot& s = slots[i];
+        if (s.id < 0)
+            return -1;
+        if (s.hash == h && word(s.id) == w)
+            return s.id;
+    }
+}
+
+void load_words(Dictionary& dictionary, const string& file_name) {
+    HW9_TIMER(LoadWords);
+    ifstream file(file_name, ios::binary);
+    if (!file) {
+        throw runtime_error("Could not open dictionary file");
+    }
+    stringstream contents;
+    contents << file.rdbuf();
+    string text = std::move(contents).str();
+
+    // 在读入的缓冲区里原地切分、转小写，构造完成前只保存指向缓冲区的 string_view
+    vector<string_view> words;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == string::npos)
+            eol = text.size();
+        size_t end = eol;
+        while (end > pos && (text[end - 1] == ' ' || text[end - 1] == '\r' || text[end - 1] == '\t'))
+            --end;
+        if (end > pos) {
+            for (size_t i = pos; i < end; ++i)
+                text[i] = static_cast<char>(tolower(static_cast<unsigned char>(text[i])));
+            words.emplace_back(text.data() + pos, end - pos);
+        }
+        pos = eol + 1;
+    }
+    dictionary = Dictionary(std::move(words));
+}
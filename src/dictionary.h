@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// 只读词典：所有单词去重排序后连续存放在同一块内存里，每个单词有一个稠密的整数 ID。
+// ID 的顺序就是单词的字典序，所以按 ID 比较等价于按字符串比较。
+// 查找用线性探测的开放寻址哈希表，槽里同时存哈希值，大多数不命中的探测不需要比较字符串。
+// 与 CSRGraph 一样，数组可以由词典自身持有，也可以指向 mmap 的索引文件（见 word_index.h）
+class Dictionary {
+public:
+    struct Slot {
+        uint32_t hash;
+        int32_t id;
+    };
+
+    Dictionary() = default;
+    explicit Dictionary(vector<string_view> words);
+    Dictionary(span<const char> arena, span<const uint32_t> offsets, span<const Slot> slots,
+               shared_ptr<const void> owner);
+
+    template <typename Range>
+    static Dictionary from(const Range& words) {
+        vector<string_view> views;
+        for (const auto& w : words)
+            views.emplace_back(w);
+        return Dictionary(std::move(views));
+    }
+
+    int size() const { return offsets.empty() ? 0 : static_cast<int>(offsets.size()) - 1; }
+    bool empty() const { return size() == 0; }
+
+    string_view word(int id) const {
+        return string_view(arena.data() + offsets[id], offsets[id + 1] - offsets[id]);
+    }
+
+    // 词典中出现过的所有字符，按字节值升序
+    string_view alphabet() const { return characters; }
+
+    // 返回单词的 ID，不存在时返回 -1
+    int find(string_view w) const;
+    bool contains(string_view w) const { return find(w) >= 0; }
+
+    span<const char> arena_array() const { return arena; }
+    span<const uint32_t> offsets_array() const { return offsets; }
+    span<const Slot> slot_array() const { return slots; }
+
+private:
+    static uint32_t hash_of(string_view w);
+    void collect_alphabet();
+
+    span<const char> arena;
+    span<const uint32_t> offsets;
+    span<const Slot> slots;
+    uint32_t mask = 0;
+    string characters;
+    shared_ptr<const void> storage;
+};
+
+// 与 load_words(set<string>&, ...) 相同的规则：每行去掉行尾空白并转成小写，忽略空行。
+// 整个文件一次读入，dictionary 原有的内容被替换
+void load_words(Dictionary& dictionary, const string& file_name);
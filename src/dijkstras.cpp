@@ -1,52 +1,85 @@
 #include "dijkstras.h"
+#include "graph_io.h"
 
-struct Node {
-    int vertex;
-    int weight;
-    
-    Node(int v, int w) : vertex(v), weight(w) {}
-    
-    bool operator>(const Node& other) const {
-        return weight > other.weight;
-    }
+namespace {
+struct CSRStorage {
+    vector<int> offsets;
+    vector<int> dst;
+    vector<int> weight;
 };
+}
 
-vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& previous) {
-    int n = G.numVertices;
-    vector<int> distance(n, INF);
-    previous.resize(n, -1);
-    vector<bool> visited(n, false);
-    
-    priority_queue<Node, vector<Node>, greater<Node>> pq;
-    
-    pq.push(Node(source, 0));
-    distance[source] = 0;
-    
-    while (!pq.empty()) {
-        Node current = pq.top();
-        pq.pop();
-        
-        int u = current.vertex;
-        
-        if (visited[u]) {
-            continue;
-        }
-        
-        visited[u] = true;
-        
-        for (const Edge& edge : G[u]) {
-            int v = edge.dst;
-            int weight = edge.weight;
-            
-            if (!visited[v] && distance[u] != INF && distance[u] + weight < distance[v]) {
-                distance[v] = distance[u] + weight;
-                previous[v] = u;
-                pq.push(Node(v, distance[v]));
-            }
-        }
+CSRGraph::CSRGraph(int n, vector<int> offsets, vector<int> dst, vector<int> weight) {
+    if (n < 0 || offsets.size() != static_cast<size_t>(n) + 1 || dst.size() != weight.size()
+        || offsets.front() != 0 || offsets.back() != static_cast<int>(dst.size()))
+        throw runtime_error("Malformed CSR arrays");
+    auto owned = make_shared<CSRStorage>(CSRStorage{std::move(offsets), std::move(dst), std::move(weight)});
+    numVertices = n;
+    this->offsets = owned->offsets;
+    this->dst = owned->dst;
+    this->weight = owned->weight;
+    storage = std::move(owned);
+}
+
+CSRGraph::CSRGraph(int n, span<const int> offsets, span<const int> dst, span<const int> weight,
+                   shared_ptr<const void> owner)
+    : numVertices(n), offsets(offsets), dst(dst), weight(weight), storage(std::move(owner)) {}
+
+CSRGraph::CSRGraph(const Graph& G) {
+    vector<Edge> edges;
+    for (const auto& adj : G)
+        edges.insert(edges.end(), adj.begin(), adj.end());
+    build(G.numVertices, edges);
+}
+
+// 按源顶点计数排序，保持每个顶点出边的输入顺序
+void CSRGraph::build(int n, const vector<Edge>& edges) {
+    vector<int> offs(n + 1, 0);
+    for (const Edge& e : edges) {
+        if (e.src < 0 || e.src >= n || e.dst < 0 || e.dst >= n)
+            throw runtime_error("Edge vertex out of range");
+        ++offs[e.src + 1];
     }
-    
-    return distance;
+    for (int u = 0; u < n; ++u)
+        offs[u + 1] += offs[u];
+
+    vector<int> d(edges.size()), w(edges.size());
+    vector<int> next(offs.begin(), offs.end() - 1);
+    for (const Edge& e : edges) {
+        int i = next[e.src]++;
+        d[i] = e.dst;
+        w[i] = e.weight;
+    }
+    *this = CSRGraph(n, std::move(offs), std::move(d), std::move(w));
+}
+
+istream& operator>>(istream& in, CSRGraph& G) {
+    int n = 0;
+    if (!(in >> n))
+        throw runtime_error("Unable to find input file");
+    vector<Edge> edges;
+    for (Edge e; in >> e;)
+        edges.push_back(e);
+    G.build(n, edges);
+    return in;
+}
+
+void file_to_graph(const string& filename, Graph& G) {
+    HW9_TIMER(FileToGraph);
+    load_graph_text(filename, G);
+}
+
+void file_to_graph(const string& filename, CSRGraph& G) {
+    HW9_TIMER(FileToGraph);
+    load_graph(filename, G);
+}
+
+vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& previous) {
+    return dijkstra_shortest_path<LazyBinaryHeap>(G, source, previous);
+}
+
+vector<int> dijkstra_shortest_path(const CSRGraph& G, int source, vector<int>& previous) {
+    return dijkstra_shortest_path<LazyBinaryHeap>(G, source, previous);
 }
 
 vector<int> extract_shortest_path(const vector<int>& distances, const vector<int>& previous, int destination) {
@@ -56,27 +89,38 @@ vector<int> extract_shortest_path(const vector<int>& distances, const vector<int
         return path;
     }
     
-    // 构建从目标到源的路径
-    for (int at = destination; at != -1 && distances[at] != 0; at = previous[at]) {
+    // 沿前驱走到源点（源点的前驱是 -1），不再扫描 distances 去寻找距离为 0 的顶点
+    for (int at = destination; at != -1; at = previous[at]) {
         path.push_back(at);
     }
     
-    // 添加源顶点
-    for (size_t i = 0; i < distances.size(); i++) {
-        if (distances[i] == 0) {
-            path.push_back(i);
-            break;
-        }
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+vector<int> extract_shortest_path(const vector<int>& distances, const vector<int>& previous, int source,
+                                  int destination) {
+    vector<int> path;
+    if (distances[destination] == INF)
+        return path;
+    for (int at = destination; at != source; at = previous[at]) {
+        if (at == -1)
+            throw runtime_error("Destination is not in the source's shortest path tree");
+        path.push_back(at);
     }
-    
+    path.push_back(source);
     reverse(path.begin(), path.end());
     return path;
 }
 
+vector<int> ShortestPathTree::path_to(int destination) const {
+    return extract_shortest_path(distance, previous, source, destination);
+}
+
 void print_path(const vector<int>& path, int total) {
     if (path.empty()) {
-        cout << endl;
-        cout << "Total cost is " << total << endl;
+        cout << "\n";
+        cout << "Total cost is " << total << "\n";
         return;
     }
     
@@ -86,6 +130,6 @@ void print_path(const vector<int>& path, int total) {
             cout << " ";
         }
     }
-    cout << " " << endl;
-    cout << "Total cost is " << total << endl;
-}
\ No newline at end of file
+    cout << " \n";
+    cout << "Total cost is " << total << "\n";
+}
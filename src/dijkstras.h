@@ -1,9 +1,17 @@
+#pragma once
+
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <queue>
 #include <limits>
 #include <stack>
+#include <algorithm>
+#include <memory>
+#include <span>
+
+#include "priority_queues.h"
+#include "stats.h"
 
 using namespace std;
 
@@ -38,15 +46,120 @@ inline istream& operator>>(istream& in, Graph& G) {
     return in;
 }
 
-inline void file_to_graph(const string& filename, Graph& G) {
-    ifstream in(filename);
-    if (!in) {
-        throw runtime_error("Can't open input file");
+// 不可变的压缩稀疏行 (CSR) 图：offsets[u]..offsets[u+1] 是 u 的出边在 dst/weight 中的区间
+// 数组可以由图自身持有，也可以直接指向 mmap 的二进制图文件；owner 负责保持其生命周期
+class CSRGraph {
+public:
+    CSRGraph() = default;
+    explicit CSRGraph(const Graph& G);
+    CSRGraph(int n, vector<int> offsets, vector<int> dst, vector<int> weight);
+    CSRGraph(int n, span<const int> offsets, span<const int> dst, span<const int> weight,
+             shared_ptr<const void> owner);
+
+    int num_vertices() const { return numVertices; }
+    int num_edges() const { return static_cast<int>(dst.size()); }
+    int edges_begin(int u) const { return offsets[u]; }
+    int edges_end(int u) const { return offsets[u + 1]; }
+    int edge_dst(int i) const { return dst[i]; }
+    int edge_weight(int i) const { return weight[i]; }
+
+    friend istream& operator>>(istream& in, CSRGraph& G);
+
+    span<const int> offsets_array() const { return offsets; }
+    span<const int> dst_array() const { return dst; }
+    span<const int> weight_array() const { return weight; }
+
+private:
+    void build(int n, const vector<Edge>& edges);
+
+    int numVertices=0;
+    span<const int> offsets;
+    span<const int> dst;
+    span<const int> weight;
+    shared_ptr<const void> storage;
+};
+
+inline int num_vertices(const Graph& G) { return G.numVertices; }
+inline int num_vertices(const CSRGraph& G) { return G.num_vertices(); }
+
+template <typename F>
+inline void for_each_edge(const Graph& G, int u, F&& f) {
+    for (const Edge& e : G[u])
+        f(e.dst, e.weight);
+}
+
+template <typename F>
+inline void for_each_edge(const CSRGraph& G, int u, F&& f) {
+    for (int i = G.edges_begin(u), end = G.edges_end(u); i < end; ++i)
+        f(G.edge_dst(i), G.edge_weight(i));
+}
+
+// 通过 mmap 加载；CSRGraph 版本同时识别 graph_io.h 中的二进制格式
+void file_to_graph(const string& filename, Graph& G);
+void file_to_graph(const string& filename, CSRGraph& G);
+
+template <typename GraphT>
+int max_edge_weight(const GraphT& G) {
+    int max_weight = 0;
+    for (int u = 0; u < num_vertices(G); ++u)
+        for_each_edge(G, u, [&](int, int w) { max_weight = max(max_weight, w); });
+    return max_weight;
+}
+
+// 可替换优先队列的 Dijkstra（队列接口见 priority_queues.h）；
+// 距离与默认实现相同，前驱只在等长路径之间可能不同
+template <typename Queue, typename GraphT>
+vector<int> dijkstra_shortest_path(const GraphT& G, int source, vector<int>& previous) {
+    HW9_TIMER(DijkstraSearch);
+    HW9_LOCAL_COUNTS(counts);
+    int n = num_vertices(G);
+    vector<int> distance(n, INF);
+    previous.assign(n, -1);
+    vector<bool> visited(n, false);
+
+    Queue pq;
+    pq.reset(n, Queue::needs_max_weight ? max_edge_weight(G) : 0);
+
+    pq.push(source, 0);
+    HW9_LOCAL_COUNT(counts, DijkstraPushes);
+    distance[source] = 0;
+
+    while (!pq.empty()) {
+        int u = pq.pop().first;
+        HW9_LOCAL_COUNT(counts, DijkstraPops);
+        if (visited[u]) {
+            HW9_LOCAL_COUNT(counts, DijkstraStalePops);
+            continue;
+        }
+        visited[u] = true;
+
+        for_each_edge(G, u, [&](int v, int weight) {
+            HW9_LOCAL_COUNT(counts, DijkstraRelaxations);
+            if (!visited[v] && distance[u] + weight < distance[v]) {
+                distance[v] = distance[u] + weight;
+                previous[v] = u;
+                pq.push(v, distance[v]);
+                HW9_LOCAL_COUNT(counts, DijkstraPushes);
+            }
+        });
     }
-    in >> G;
-    in.close();
+
+    return distance;
 }
 
 vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& previous);
+vector<int> dijkstra_shortest_path(const CSRGraph& G, int source, vector<int>& previous);
+
+// 一个源点的完整最短路径树，与 dijkstra_shortest_path 的返回值和 previous 相同
+struct ShortestPathTree {
+    int source = -1;
+    vector<int> distance;
+    vector<int> previous;
+
+    // 按需重建到某个顶点的路径，不可达时为空
+    vector<int> path_to(int destination) const;
+};
 vector<int> extract_shortest_path(const vector<int>& /*distances*/, const vector<int>& previous, int destination);
+vector<int> extract_shortest_path(const vector<int>& distances, const vector<int>& previous, int source,
+                                  int destination);
 void print_path(const vector<int>& v, int total);
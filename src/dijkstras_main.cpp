@@ -1,22 +1,90 @@
 #include "dijkstras.h"
+#include "shortest_path.h"
+#include "tree_export.h"
+#include "stats.h"
 
-int main() {
-    Graph G;
+// dijkstra_main [--format paths|text|csv|binary] [--stats] [graph] [source target]
+//   graph 可以是文本图文件，也可以是 graph_convert 生成的二进制图文件；
+//   只给出图时从 0 出发导出整棵最短路径树，再给出源点和目标点时只回答这一条查询。
+//   --stats 在结束时把计数器和计时器以 JSON 写到标准错误
+//   不给任何位置参数时读取 small.txt
+static int usage_error(const string& message) {
+    cout << "Error: " << message << endl;
+    cout << "Usage: dijkstra_main [--format paths|text|csv|binary] [--stats] [graph] [source target]" << endl;
+    return 2;
+}
+
+// 整个参数都必须是十进制整数
+static int parse_vertex(const string& arg) {
+    size_t used = 0;
+    int v = stoi(arg, &used);
+    if (used != arg.size())
+        throw invalid_argument(arg);
+    return v;
+}
+
+int main(int argc, char* argv[]) {
+    TreeFormat format = TreeFormat::Paths;
+    bool print_stats = false;
+    vector<string> args;
     try {
-        file_to_graph("small.txt", G);
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "--format") {
+                if (i + 1 >= argc)
+                    return usage_error("--format needs a value");
+                format = parse_tree_format(argv[++i]);
+            } else if (arg == "--stats") {
+                print_stats = true;
+            } else {
+                args.push_back(arg);
+            }
+        }
+    } catch (const runtime_error& e) {
+        return usage_error(e.what());
+    }
+    if (args.size() == 2 || args.size() > 3)
+        return usage_error("expected a graph file, optionally followed by source and target");
+
+    int source = 0, target = 0;
+    if (args.size() == 3) {
+        try {
+            source = parse_vertex(args[1]);
+            target = parse_vertex(args[2]);
+        } catch (const logic_error&) {
+            return usage_error("source and target must be vertex numbers");
+        }
+    }
+
+    string filename = !args.empty() ? args[0] : "small.txt";
+    CSRGraph G;
+    try {
+        file_to_graph(filename, G);
     } catch (const runtime_error& e) {
         cout << "Error: " << e.what() << endl;
         return 1;
     }
     
-    vector<int> previous;
-    vector<int> distances = dijkstra_shortest_path(G, 0, previous);
-    
-    // 打印从源（0）到所有顶点的最短路径
-    for (int i = 0; i < G.numVertices; i++) {
-        cout << "\nShortest path from 0 to " << i << ":" << endl;
-        vector<int> path = extract_shortest_path(distances, previous, i);
-        print_path(path, distances[i]);
+    if (args.size() == 3) {
+        if (source < 0 || source >= G.num_vertices() || target < 0 || target >= G.num_vertices()) {
+            cout << "Error: vertex out of range" << endl;
+            return 1;
+        }
+        PathResult result = shortest_path(G, source, target, {QueryMode::Bidirectional, {}});
+        cout << "Shortest path from " << source << " to " << target << ":" << endl;
+        print_path(result.path, result.cost);
+        if (print_stats)
+            stats::write_json(cerr);
+        return 0;
+    }
+
+    ShortestPathTree tree;
+    tree.source = 0;
+    tree.distance = dijkstra_shortest_path(G, tree.source, tree.previous);
+    export_shortest_path_tree(cout, tree, format);
+    if (print_stats) {
+        cout.flush();
+        stats::write_json(cerr);
     }
     
     return 0;
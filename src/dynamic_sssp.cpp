@@ -0,0 +1,130 @@
+#include "dynamic_sssp.h"
+
+DynamicSSSP::DynamicSSSP(const CSRGraph& G, int source)
+    : src(source), out(G.num_vertices()), in(G.num_vertices()), affected(G.num_vertices(), 0) {
+    if (source < 0 || source >= G.num_vertices())
+        throw runtime_error("Vertex out of range");
+    for (int u = 0; u < G.num_vertices(); ++u)
+        for_each_edge(G, u, [&](int v, int w) {
+            if (w < 0)
+                throw runtime_error("DynamicSSSP requires non-negative weights");
+            out[u].push_back({v, w});
+            in[v].push_back({u, w});
+        });
+    dist = dijkstra_shortest_path<DaryHeap<4>>(G, source, prev);
+    heap.reset(G.num_vertices());
+}
+
+DynamicSSSP::DynamicSSSP(const Graph& G, int source) : DynamicSSSP(CSRGraph(G), source) {}
+
+void DynamicSSSP::check_vertices(int u, int v) const {
+    if (u < 0 || u >= num_vertices() || v < 0 || v >= num_vertices())
+        throw runtime_error("Vertex out of range");
+}
+
+DynamicSSSP::Arc& DynamicSSSP::find_arc(vector<Arc>& arcs, int node) {
+    for (Arc& a : arcs)
+        if (a.node == node)
+            return a;
+    throw runtime_error("Edge not found");
+}
+
+void DynamicSSSP::set_edge_weight(int u, int v, int weight) {
+    check_vertices(u, v);
+    if (weight < 0)
+        throw runtime_error("DynamicSSSP requires non-negative weights");
+    Arc& forward = find_arc(out[u], v);
+    int old_weight = forward.weight;
+    forward.weight = weight;
+    find_arc(in[v], u).weight = weight;
+    if (weight < old_weight)
+        edge_improved(u, v, weight);
+    else if (weight > old_weight)
+        edge_worsened(u, v);
+}
+
+void DynamicSSSP::insert_edge(int u, int v, int weight) {
+    check_vertices(u, v);
+    if (weight < 0)
+        throw runtime_error("DynamicSSSP requires non-negative weights");
+    out[u].push_back({v, weight});
+    in[v].push_back({u, weight});
+    edge_improved(u, v, weight);
+}
+
+void DynamicSSSP::delete_edge(int u, int v) {
+    check_vertices(u, v);
+    // 保持顺序地删除，使 out 与 in 中平行边的“第一条”始终是同一条
+    out[u].erase(out[u].begin() + (&find_arc(out[u], v) - out[u].data()));
+    in[v].erase(in[v].begin() + (&find_arc(in[v], u) - in[v].data()));
+    edge_worsened(u, v);
+}
+
+void DynamicSSSP::edge_improved(int u, int v, int weight) {
+    if (dist[u] == INF || dist[u] + weight >= dist[v])
+        return;
+    heap.reset(num_vertices());
+    dist[v] = dist[u] + weight;
+    prev[v] = u;
+    heap.push(v, dist[v]);
+    propagate();
+}
+
+// 只有树边 prev[v] == u 变差才会影响距离；受影响的恰好是 v 在最短路径树中的子树
+void DynamicSSSP::edge_worsened(int u, int v) {
+    if (prev[v] != u)
+        return;
+
+    vector<int> subtree{v};
+    affected[v] = 1;
+    for (size_t i = 0; i < subtree.size(); ++i) {
+        int x = subtree[i];
+        for (const Arc& a : out[x])
+            if (prev[a.node] == x && !affected[a.node]) {
+                affected[a.node] = 1;
+                subtree.push_back(a.node);
+            }
+    }
+
+    for (int x : subtree) {
+        dist[x] = INF;
+        prev[x] = -1;
+    }
+    heap.reset(num_vertices());
+    for (int x : subtree) {
+        for (const Arc& a : in[x]) {
+            if (affected[a.node] || dist[a.node] == INF || dist[a.node] + a.weight >= dist[x])
+                continue;
+            dist[x] = dist[a.node] + a.weight;
+            prev[x] = a.node;
+        }
+        if (dist[x] != INF)
+            heap.push(x, dist[x]);
+    }
+    for (int x : subtree)
+        affected[x] = 0;
+    propagate();
+}
+
+void DynamicSSSP::propagate() {
+    while (!heap.empty()) {
+        auto [x, dx] = heap.pop();
+        for (const Arc& a : out[x]) {
+            if (dx + a.weight < dist[a.node]) {
+                dist[a.node] = dx + a.weight;
+                prev[a.node] = x;
+                heap.push(a.node, dist[a.node]);
+            }
+        }
+    }
+}
+
+Graph DynamicSSSP::graph() const {
+    Graph G;
+    G.numVertices = num_vertices();
+    G.resize(num_vertices());
+    for (int u = 0; u < num_vertices(); ++u)
+        for (const Arc& a : out[u])
+            G[u].emplace_back(u, a.node, a.weight);
+    return G;
+}
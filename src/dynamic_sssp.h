@@ -0,0 +1,46 @@
+#pragma once
+
+#include "dijkstras.h"
+
+// 在边权变化时维护单源最短路径树（Ramalingam–Reps 风格）。
+// 降低权重或插入边时，只从被改进的顶点向外做 Dijkstra 传播；
+// 提高权重或删除树边时，只把该边下方的子树置为 INF，用子树外的入边重新给出候选距离，
+// 再在子树内做 Dijkstra。distance()/previous() 可直接交给 extract_shortest_path。
+// 权重必须非负；同一对顶点之间有多条边时，修改和删除作用于第一条
+class DynamicSSSP {
+public:
+    DynamicSSSP(const Graph& G, int source);
+    DynamicSSSP(const CSRGraph& G, int source);
+
+    int source() const { return src; }
+    int num_vertices() const { return static_cast<int>(out.size()); }
+    const vector<int>& distance() const { return dist; }
+    const vector<int>& previous() const { return prev; }
+
+    void set_edge_weight(int u, int v, int weight);
+    void insert_edge(int u, int v, int weight);
+    void delete_edge(int u, int v);
+
+    // 当前的边集合，用于与完整重算的结果对比
+    Graph graph() const;
+
+private:
+    struct Arc {
+        int node;
+        int weight;
+    };
+
+    void check_vertices(int u, int v) const;
+    Arc& find_arc(vector<Arc>& arcs, int node);
+    void edge_improved(int u, int v, int weight);
+    void edge_worsened(int u, int v);
+    void propagate();
+
+    int src;
+    vector<vector<Arc>> out;
+    vector<vector<Arc>> in;
+    vector<int> dist;
+    vector<int> prev;
+    vector<char> affected;
+    DaryHeap<4> heap;
+};
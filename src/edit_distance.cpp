@@ -0,0 +1,223 @@
+#include "edit_distance.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+namespace {
+
+const array<unsigned char, 256> LOWER = [] {
+    array<unsigned char, 256> table{};
+    for (int c = 0; c < 256; ++c)
+        table[c] = static_cast<unsigned char>(tolower(c));
+    return table;
+}();
+
+inline unsigned char fold(char c) {
+    return LOWER[static_cast<unsigned char>(c)];
+}
+
+// 保证 a 不长于 b
+inline void order_by_length(string_view& a, string_view& b) {
+    if (a.size() > b.size())
+        swap(a, b);
+}
+
+int within_one(string_view a, string_view b) {
+    order_by_length(a, b);
+    size_t i = 0;
+    while (i < a.size() && fold(a[i]) == fold(b[i]))
+        ++i;
+    if (i == a.size())
+        return static_cast<int>(b.size() - a.size());
+    size_t skip_a = a.size() == b.size() ? 1 : 0;
+    string_view rest_a = a.substr(i + skip_a), rest_b = b.substr(i + 1);
+    if (rest_a.size() != rest_b.size())
+        return 2;
+    for (size_t k = 0; k < rest_a.size(); ++k)
+        if (fold(rest_a[k]) != fold(rest_b[k]))
+            return 2;
+    return 1;
+}
+
+const int MAX_STACK_BAND = 64;
+
+// Ukkonen 带状 DP：row[k] 对应 D[i][i + k - d]，超出带或字符串的格子视为 d + 1
+int banded(string_view a, string_view b, int d) {
+    int la = static_cast<int>(a.size()), lb = static_cast<int>(b.size());
+    int width = 2 * d + 1, cap = d + 1;
+    int stack_rows[2][2 * MAX_STACK_BAND + 1];
+    vector<int> heap_rows;
+    int* prev = stack_rows[0];
+    int* cur = stack_rows[1];
+    if (d > MAX_STACK_BAND) {
+        heap_rows.resize(2 * width);
+        prev = heap_rows.data();
+        cur = prev + width;
+    }
+
+    for (int k = 0; k < width; ++k) {
+        int j = k - d;
+        prev[k] = j >= 0 && j <= lb ? j : cap;
+    }
+    for (int i = 1; i <= la; ++i) {
+        int row_min = cap;
+        for (int k = 0; k < width; ++k) {
+            int j = i + k - d;
+            int v = cap;
+            if (j == 0) {
+                v = min(i, cap);
+            } else if (j > 0 && j <= lb) {
+                v = prev[k] + (fold(a[i - 1]) != fold(b[j - 1]));
+                if (k + 1 < width)
+                    v = min(v, prev[k + 1] + 1);
+                if (k > 0)
+                    v = min(v, cur[k - 1] + 1);
+                v = min(v, cap);
+            }
+            cur[k] = v;
+            row_min = min(row_min, v);
+        }
+        if (row_min >= cap)
+            return cap;
+        swap(prev, cur);
+    }
+    return prev[lb - la + d];
+}
+
+// 模式串（不超过 64 个字符）每个字符出现位置的位掩码，下标是转成小写后的字节
+struct PatternMask {
+    explicit PatternMask(string_view pattern) {
+        for (size_t j = 0; j < pattern.size(); ++j)
+            peq[fold(pattern[j])] |= uint64_t(1) << j;
+    }
+    uint64_t peq[256] = {};
+};
+
+// Myers (1999) / Hyyrö 的全局编辑距离位并行算法；pattern 非空且不超过 64 个字符
+int myers(const PatternMask& mask, size_t m, string_view text, int d) {
+    uint64_t pv = ~uint64_t(0), mv = 0;
+    uint64_t last = uint64_t(1) << (m - 1);
+    int score = static_cast<int>(m);
+    int remaining = static_cast<int>(text.size());
+    for (char c : text) {
+        uint64_t eq = mask.peq[fold(c)];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        score += (ph & last) != 0;
+        score -= (mh & last) != 0;
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        // 最后一行每多读一个字符最多减 1
+        if (score - --remaining > d)
+            return d + 1;
+    }
+    return min(score, d + 1);
+}
+
+typedef uint64_t Lanes __attribute__((vector_size(32)));
+const int LANES = sizeof(Lanes) / sizeof(uint64_t);
+
+}
+
+int bounded_edit_distance(string_view a, string_view b, int d) {
+    if (d < 0)
+        return 0;
+    order_by_length(a, b);
+    if (b.size() - a.size() > static_cast<size_t>(d))
+        return d + 1;
+    if (a.empty())
+        return static_cast<int>(b.size());
+    if (d <= 1)
+        return min(within_one(a, b), d + 1);
+    if (d <= 8 || (a.size() > 64 && d <= MAX_STACK_BAND))
+        return banded(a, b, d);
+    if (a.size() <= 64)
+        return myers(PatternMask(a), a.size(), b, d);
+    return banded(a, b, d);
+}
+
+void edit_distance_within_batch(string_view word, span<const string_view> candidates, int d, span<uint8_t> out) {
+    size_t m = word.size();
+    if (m == 0 || m > 64 || d <= 1) {
+        for (size_t i = 0; i < candidates.size(); ++i)
+            out[i] = bounded_edit_distance(word, candidates[i], d) <= d;
+        return;
+    }
+
+    // 长度差超过 d 的直接排除，其余每 LANES 个一组同时计算；各条道的文本长度不同，
+    // 读完的道只是不再更新分数
+    PatternMask mask(word);
+    size_t lane_index[LANES];
+    int filled = 0;
+    auto run = [&]() {
+        Lanes pv, mv = {}, score, length = {};
+        for (int l = 0; l < LANES; ++l) {
+            pv[l] = ~uint64_t(0);
+            score[l] = m;
+            length[l] = l < filled ? candidates[lane_index[l]].size() : 0;
+        }
+        size_t longest = 0;
+        for (int l = 0; l < filled; ++l)
+            longest = max<size_t>(longest, length[l]);
+        for (size_t j = 0; j < longest; ++j) {
+            Lanes eq, active;
+            for (int l = 0; l < LANES; ++l) {
+                bool in_text = j < length[l];
+                eq[l] = in_text ? mask.peq[fold(candidates[lane_index[l]][j])] : 0;
+                active[l] = in_text;
+            }
+            Lanes xv = eq | mv;
+            Lanes xh = (((eq & pv) + pv) ^ pv) | eq;
+            Lanes ph = mv | ~(xh | pv);
+            Lanes mh = pv & xh;
+            score += ((ph >> (m - 1)) & 1 & active);
+            score -= ((mh >> (m - 1)) & 1 & active);
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+        }
+        for (int l = 0; l < filled; ++l)
+            out[lane_index[l]] = score[l] <= static_cast<uint64_t>(d);
+        filled = 0;
+    };
+
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        size_t n = candidates[i].size();
+        if ((n > m ? n - m : m - n) > static_cast<size_t>(d)) {
+            out[i] = 0;
+            continue;
+        }
+        if (n == 0) {
+            out[i] = m <= static_cast<size_t>(d);
+            continue;
+        }
+        lane_index[filled++] = i;
+        if (filled == LANES)
+            run();
+    }
+    if (filled > 0)
+        run();
+}
+
+vector<int> find_within_distance(const Dictionary& dictionary, string_view word, int d) {
+    const int BLOCK = 256;
+    vector<int> result;
+    string_view block[BLOCK];
+    uint8_t within[BLOCK];
+    for (int start = 0; start < dictionary.size(); start += BLOCK) {
+        int count = min(BLOCK, dictionary.size() - start);
+        for (int i = 0; i < count; ++i)
+            block[i] = dictionary.word(start + i);
+        edit_distance_within_batch(word, span(block, count), d, span(within, count));
+        for (int i = 0; i < count; ++i)
+            if (within[i])
+                result.push_back(start + i);
+    }
+    return result;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "dictionary.h"
+
+using namespace std;
+
+// 忽略大小写的有界编辑距离：返回 min(距离, d + 1)，d < 0 时返回 0。不分配内存（两个字符串都超过
+// 64 个字符且 d > 64 时除外）：
+//   d <= 1        去掉公共前后缀后直接判断
+//   d <= 8        Ukkonen 带状 DP，只算对角线附近 2d+1 格，整行超过 d 时提前结束
+//   较短串 <= 64  Myers 位并行算法，每个字符 O(1) 次字长运算
+int bounded_edit_distance(string_view a, string_view b, int d);
+
+// 一个单词对多个候选词：out[i] = bounded_edit_distance(word, candidates[i], d) <= d。
+// word 不超过 64 个字符时，用 GCC 向量扩展让多个候选词同时走 Myers 算法
+void edit_distance_within_batch(string_view word, span<const string_view> candidates, int d, span<uint8_t> out);
+
+// 扫描整个词典，返回与 word 编辑距离不超过 d 的单词 ID（升序）
+vector<int> find_within_distance(const Dictionary& dictionary, string_view word, int d);
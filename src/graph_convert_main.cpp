@@ -0,0 +1,18 @@
+#include "graph_io.h"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        cerr << "Usage: " << argv[0] << " <input.txt> <output.bin>" << endl;
+        return 2;
+    }
+    CSRGraph G;
+    try {
+        load_graph_text(argv[1], G);
+        save_graph_binary(argv[2], G);
+    } catch (const runtime_error& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Wrote " << G.num_vertices() << " vertices and " << G.num_edges() << " edges to " << argv[2] << endl;
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "graph_gen.h"
+#include "buffered_writer.h"
+
+#include <random>
+
+namespace {
+
+Graph empty_graph(int n) {
+    if (n <= 0)
+        throw runtime_error("Graph needs at least one vertex");
+    Graph G;
+    G.numVertices = n;
+    G.resize(n);
+    return G;
+}
+
+void add_edge(Graph& G, int u, int v, int w) {
+    G[u].emplace_back(u, v, w);
+}
+
+}
+
+Graph generate_random_graph(int n, int m, int max_weight, unsigned seed) {
+    Graph G = empty_graph(n);
+    mt19937 rng(seed);
+    uniform_int_distribution<int> vertex(0, n - 1), weight(1, max(1, max_weight));
+    for (int i = 0; i < m; ++i) {
+        int u = vertex(rng);
+        add_edge(G, u, vertex(rng), weight(rng));
+    }
+    return G;
+}
+
+Graph generate_grid_graph(int rows, int cols, int max_weight, unsigned seed) {
+    Graph G = empty_graph(rows * cols);
+    mt19937 rng(seed);
+    uniform_int_distribution<int> weight(1, max(1, max_weight));
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int u = r * cols + c;
+            if (c + 1 < cols) {
+                add_edge(G, u, u + 1, weight(rng));
+                add_edge(G, u + 1, u, weight(rng));
+            }
+            if (r + 1 < rows) {
+                add_edge(G, u, u + cols, weight(rng));
+                add_edge(G, u + cols, u, weight(rng));
+            }
+        }
+    }
+    return G;
+}
+
+Graph generate_power_law_graph(int n, int m, int max_weight, unsigned seed) {
+    Graph G = empty_graph(n);
+    mt19937 rng(seed);
+    uniform_int_distribution<int> weight(1, max(1, max_weight));
+    int links = max(1, m / (2 * n));
+
+    // 每条边的两个端点都记入 endpoints，从中均匀抽样即按度数加权
+    vector<int> endpoints;
+    endpoints.reserve(2 * static_cast<size_t>(n) * links);
+    for (int v = 1; v < n; ++v) {
+        for (int k = 0; k < links; ++k) {
+            int u = endpoints.empty() ? 0 : endpoints[uniform_int_distribution<size_t>(0, endpoints.size() - 1)(rng)];
+            if (u == v)
+                continue;
+            add_edge(G, v, u, weight(rng));
+            add_edge(G, u, v, weight(rng));
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    return G;
+}
+
+void write_graph_text(ostream& out, const Graph& G) {
+    BufferedWriter w(out);
+    w.write_int(G.numVertices);
+    w.put('\n');
+    for (const auto& edges : G) {
+        for (const Edge& e : edges) {
+            w.write_int(e.src);
+            w.put(' ');
+            w.write_int(e.dst);
+            w.put(' ');
+            w.write_int(e.weight);
+            w.put('\n');
+        }
+    }
+}
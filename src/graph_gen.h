@@ -0,0 +1,18 @@
+#pragma once
+
+#include "dijkstras.h"
+
+// 基准测试用的合成图，权重均匀分布在 [1, max_weight]；结果可用 write_graph_text 写成
+// operator>>(istream&, Graph&) 能读取的文本格式
+
+// n 个顶点、m 条端点均匀随机的有向边
+Graph generate_random_graph(int n, int m, int max_weight, unsigned seed);
+
+// rows x cols 的四邻接网格，每对相邻顶点之间两个方向各一条边；顶点 r * cols + c 位于 (c, r)
+Graph generate_grid_graph(int rows, int cols, int max_weight, unsigned seed);
+
+// 优先连接（Barabási–Albert）生成的幂律度分布图：每个新顶点连向 m / (2n) 个按度数加权选出的旧顶点，
+// 每条连接两个方向各一条边，共约 m 条有向边
+Graph generate_power_law_graph(int n, int m, int max_weight, unsigned seed);
+
+void write_graph_text(ostream& out, const Graph& G);
@@ -0,0 +1,193 @@
+#include "graph_io.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+// 与 istream >> int 的行为一致：跳过空白，遇到无法解析的字符后停止，之后的读取都失败
+class IntScanner {
+public:
+    explicit IntScanner(string_view text) : p(text.data()), end(text.data() + text.size()) {}
+
+    bool next(int& out) {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t' || *p == '\v' || *p == '\f'))
+            ++p;
+        if (p == end)
+            return false;
+        bool negative = false;
+        if (*p == '-' || *p == '+') {
+            negative = *p == '-';
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9') {
+            p = end;
+            return false;
+        }
+        long long value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p - '0');
+            if (value > static_cast<long long>(INT_MAX) + 1)
+                throw runtime_error("Integer out of range in graph file");
+            ++p;
+        }
+        if (negative)
+            value = -value;
+        if (value > INT_MAX)
+            throw runtime_error("Integer out of range in graph file");
+        out = static_cast<int>(value);
+        return true;
+    }
+
+private:
+    const char* p;
+    const char* end;
+};
+
+int scan_vertex_count(IntScanner& scan) {
+    int n = 0;
+    if (!scan.next(n))
+        throw runtime_error("Unable to find input file");
+    if (n < 0)
+        throw runtime_error("Negative vertex count");
+    return n;
+}
+
+// 对每条完整的边调用 f；不完整的尾部三元组被忽略，与 operator>> 相同
+template <typename F>
+void scan_edges(IntScanner scan, int n, F&& f) {
+    int src, dst, weight;
+    while (scan.next(src) && scan.next(dst) && scan.next(weight)) {
+        if (src < 0 || src >= n || dst < 0 || dst >= n)
+            throw runtime_error("Edge vertex out of range");
+        f(src, dst, weight);
+    }
+}
+
+// 第一遍统计出度，返回 CSR 偏移数组
+vector<int> count_degrees(const IntScanner& edges, int n) {
+    vector<int> offsets(n + 1, 0);
+    scan_edges(edges, n, [&](int src, int, int) { ++offsets[src + 1]; });
+    for (int u = 0; u < n; ++u)
+        offsets[u + 1] += offsets[u];
+    return offsets;
+}
+
+CSRGraph map_binary_graph(shared_ptr<const MappedFile> file) {
+    GraphFileHeader header;
+    if (file->size() < sizeof(header))
+        throw runtime_error("Truncated graph file");
+    memcpy(&header, file->data(), sizeof(header));
+    if (memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic)) != 0)
+        throw runtime_error("Not a binary graph file");
+    if (header.version != GRAPH_FILE_VERSION)
+        throw runtime_error("Unsupported graph file version");
+    if (header.numVertices < 0 || header.numEdges < 0 || header.numEdges > INT_MAX)
+        throw runtime_error("Malformed graph file header");
+
+    size_t n = header.numVertices;
+    size_t m = header.numEdges;
+    if (file->size() != sizeof(header) + (n + 1 + 2 * m) * sizeof(int32_t))
+        throw runtime_error("Truncated graph file");
+
+    const int* base = reinterpret_cast<const int*>(file->data() + sizeof(header));
+    span<const int> offsets(base, n + 1);
+    span<const int> dst(base + n + 1, m);
+    span<const int> weight(base + n + 1 + m, m);
+    if (offsets.front() != 0 || offsets.back() != static_cast<int>(m) || !is_sorted(offsets.begin(), offsets.end()))
+        throw runtime_error("Malformed graph file offsets");
+    // 与文本格式一样检查端点；权重在文本格式中也可以是任意 int，不需要检查
+    for (int v : dst)
+        if (v < 0 || v >= header.numVertices)
+            throw runtime_error("Edge vertex out of range");
+    return CSRGraph(header.numVertices, offsets, dst, weight, std::move(file));
+}
+
+bool has_graph_magic(const MappedFile& file) {
+    return file.size() >= sizeof(GRAPH_FILE_MAGIC)
+        && memcmp(file.data(), GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC)) == 0;
+}
+
+}
+
+void parse_graph_text(string_view text, Graph& G) {
+    IntScanner scan(text);
+    int n = scan_vertex_count(scan);
+    vector<int> offsets = count_degrees(scan, n);
+
+    G.clear();
+    G.numVertices = n;
+    G.resize(n);
+    for (int u = 0; u < n; ++u)
+        G[u].reserve(offsets[u + 1] - offsets[u]);
+    scan_edges(scan, n, [&](int src, int dst, int weight) { G[src].emplace_back(src, dst, weight); });
+}
+
+void parse_graph_text(string_view text, CSRGraph& G) {
+    IntScanner scan(text);
+    int n = scan_vertex_count(scan);
+    vector<int> offsets = count_degrees(scan, n);
+
+    vector<int> dst(offsets.back()), weight(offsets.back());
+    vector<int> next(offsets.begin(), offsets.end() - 1);
+    scan_edges(scan, n, [&](int src, int d, int w) {
+        int i = next[src]++;
+        dst[i] = d;
+        weight[i] = w;
+    });
+    G = CSRGraph(n, std::move(offsets), std::move(dst), std::move(weight));
+}
+
+void load_graph_text(const string& filename, Graph& G) {
+    MappedFile file(filename);
+    parse_graph_text(string_view(file.data(), file.size()), G);
+}
+
+void load_graph_text(const string& filename, CSRGraph& G) {
+    MappedFile file(filename);
+    parse_graph_text(string_view(file.data(), file.size()), G);
+}
+
+void save_graph_binary(const string& filename, const CSRGraph& G) {
+    ofstream out(filename, ios::binary);
+    if (!out)
+        throw runtime_error("Can't open output file");
+
+    GraphFileHeader header{};
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.numVertices = G.num_vertices();
+    header.numEdges = G.num_edges();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    auto write_array = [&](span<const int> a) {
+        out.write(reinterpret_cast<const char*>(a.data()), a.size_bytes());
+    };
+    if (G.num_vertices() == 0) {
+        const int zero = 0;
+        out.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+    } else {
+        write_array(G.offsets_array());
+    }
+    write_array(G.dst_array());
+    write_array(G.weight_array());
+    if (!out)
+        throw runtime_error("Failed to write graph file");
+}
+
+void load_graph_binary(const string& filename, CSRGraph& G) {
+    G = map_binary_graph(make_shared<const MappedFile>(filename));
+}
+
+bool is_graph_binary(const string& filename) {
+    return has_graph_magic(MappedFile(filename));
+}
+
+void load_graph(const string& filename, CSRGraph& G) {
+    auto file = make_shared<const MappedFile>(filename);
+    if (has_graph_magic(*file))
+        G = map_binary_graph(std::move(file));
+    else
+        parse_graph_text(string_view(file->data(), file->size()), G);
+}
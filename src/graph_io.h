@@ -0,0 +1,38 @@
+#pragma once
+
+#include "dijkstras.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <string_view>
+
+// 二进制图文件（本机字节序）：
+//   GraphFileHeader
+//   int32 offsets[numVertices + 1]
+//   int32 dst[numEdges]
+//   int32 weight[numEdges]
+struct GraphFileHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t numVertices;
+    int32_t reserved;
+    int64_t numEdges;
+};
+
+constexpr char GRAPH_FILE_MAGIC[4] = {'H', 'W', '9', 'G'};
+constexpr uint32_t GRAPH_FILE_VERSION = 1;
+
+// 与 operator>>(istream&, Graph&) 相同的文本格式，但用无分配的扫描器解析 mmap 的内容，
+// 先统计每个顶点的出度再一次性分配邻接存储
+void parse_graph_text(string_view text, Graph& G);
+void parse_graph_text(string_view text, CSRGraph& G);
+void load_graph_text(const string& filename, Graph& G);
+void load_graph_text(const string& filename, CSRGraph& G);
+
+// 二进制格式直接映射，不做任何解析；返回的图持有映射
+void save_graph_binary(const string& filename, const CSRGraph& G);
+void load_graph_binary(const string& filename, CSRGraph& G);
+bool is_graph_binary(const string& filename);
+
+// 根据文件头自动选择二进制或文本格式
+void load_graph(const string& filename, CSRGraph& G);
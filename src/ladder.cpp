@@ -1,4 +1,5 @@
 #include "ladder.h"
+#include "stats.h"
 
 void error(string word1, string word2, string msg) {
     cout << "Error: " << msg << endl;
@@ -7,60 +8,16 @@ void error(string word1, string word2, string msg) {
 }
 
 bool edit_distance_within(const string& str1, const string& str2, int d) {
-    if (abs((int)str1.length() - (int)str2.length()) > d) return false;
-    
-    vector<vector<int>> dp(str1.length() + 1, vector<int>(str2.length() + 1));
-    
-    for (size_t i = 0; i <= str1.length(); i++)
-        dp[i][0] = i;
-    for (size_t j = 0; j <= str2.length(); j++)
-        dp[0][j] = j;
-        
-    for (size_t i = 1; i <= str1.length(); i++) {
-        for (size_t j = 1; j <= str2.length(); j++) {
-            if (tolower(str1[i-1]) == tolower(str2[j-1]))
-                dp[i][j] = dp[i-1][j-1];
-            else
-                dp[i][j] = 1 + min({dp[i-1][j], dp[i][j-1], dp[i-1][j-1]});
-        }
-    }
-    return dp[str1.length()][str2.length()] <= d;
+    // 有界内核见 edit_distance.h，不再分配整张 DP 表
+    return bounded_edit_distance(str1, str2, d) <= d;
 }
 
 bool is_adjacent(const string& word1, const string& word2) {
     return edit_distance_within(word1, word2, 1);
 }
 
-vector<string> generate_neighbors(const string& word) {
-    vector<string> neighbors;
-    const string letters = "abcdefghijklmnopqrstuvwxyz";
-
-    // 尝试改变每个字母
-    for (size_t i = 0; i < word.size(); ++i) {
-        for (char c : letters) {
-            if (c == word[i]) continue;
-            string neighbor = word;
-            neighbor[i] = c;
-            neighbors.push_back(neighbor);
-        }
-    }
-
-    // 尝试插入一个字母
-    for (size_t i = 0; i <= word.size(); ++i) {
-        for (char c : letters) {
-            neighbors.push_back(word.substr(0, i) + c + word.substr(i));
-        }
-    }
-
-    // 尝试删除一字母
-    for (size_t i = 0; i < word.size(); ++i) {
-        neighbors.push_back(word.substr(0, i) + word.substr(i + 1));
-    }
-
-    return neighbors;
-}
-
 void load_words(set<string>& word_list, const string& file_name) {
+    HW9_TIMER(LoadWords);
     ifstream file(file_name);
     if (!file) {
         throw runtime_error("Could not open dictionary file");
@@ -78,7 +35,273 @@ void load_words(set<string>& word_list, const string& file_name) {
     }
 }
 
-vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const set<string>& word_list) {
+namespace {
+
+// 逐个试探一步编辑得到的字符串（替换、插入、删除），候选词写进同一个缓冲区后调用 f；
+// 规则与 WordTrie 沿字典树枚举的邻居相同，只是还会试探词典里不存在的字符串
+template <typename F>
+void for_each_candidate(const string& word, string& candidate, F&& f) {
+    // 尝试改变一个字母
+    for (size_t i = 0; i < word.length(); i++) {
+        candidate = word;
+        for (char c = 'a'; c <= 'z'; c++) {
+            candidate[i] = c;
+            f(candidate);
+        }
+    }
+    
+    // 尝试插入一个字母
+    for (size_t i = 0; i <= word.length(); i++) {
+        for (char c = 'a'; c <= 'z'; c++) {
+            candidate.assign(word, 0, i);
+            candidate += c;
+            candidate.append(word, i);
+            f(candidate);
+        }
+    }
+    
+    // 尝试删除一个字母
+    for (size_t i = 0; i < word.length(); i++) {
+        candidate.assign(word, 0, i);
+        candidate.append(word, i + 1);
+        f(candidate);
+    }
+}
+
+// 逐个试探字符串的邻接：后继按 for_each_candidate 生成；前驱是能一步变成当前单词的单词，
+// 替换和删除时可能用到词典里出现过的任何字符。
+// 试探次数先在局部变量里累加，每次展开后加到成员 counts，搜索结束时随邻接对象一起析构、汇总
+class ProbeAdjacency {
+public:
+    ProbeAdjacency(const Dictionary& dictionary, const string& start) : dictionary(dictionary), start(start) {}
+
+    template <typename F>
+    void successors(int v, F&& f) {
+        if (v < dictionary.size()) word = dictionary.word(v);
+        else word = start;
+        [[maybe_unused]] uint64_t probes = 0;
+        for_each_candidate(word, candidate, [&](const string& new_word) {
+            ++probes;
+            int id = dictionary.find(new_word);
+            if (id >= 0)
+                f(id);
+        });
+        HW9_LOCAL_COUNT_N(counts, LadderProbes, probes);
+    }
+
+    template <typename F>
+    void predecessors(int v, F&& f) {
+        word = dictionary.word(v);
+        [[maybe_unused]] uint64_t probes = 0;
+        auto probe = [&]() {
+            ++probes;
+            int id = dictionary.find(candidate);
+            if (id >= 0)
+                f(id);
+        };
+        for (size_t i = 0; i < word.length(); i++) {
+            if (word[i] < 'a' || word[i] > 'z') continue;
+            // 由替换得到：原来的字符可以是任何字符
+            candidate = word;
+            for (char c : dictionary.alphabet()) {
+                if (c == word[i]) continue;
+                candidate[i] = c;
+                probe();
+            }
+            // 由插入一个字母得到
+            candidate.assign(word, 0, i);
+            candidate.append(word, i + 1);
+            probe();
+        }
+        // 由删除任意一个字符得到
+        for (size_t i = 0; i <= word.length(); i++) {
+            for (char c : dictionary.alphabet()) {
+                candidate.assign(word, 0, i);
+                candidate += c;
+                candidate.append(word, i);
+                probe();
+            }
+        }
+        HW9_LOCAL_COUNT_N(counts, LadderProbes, probes);
+    }
+
+private:
+    const Dictionary& dictionary;
+    const string& start;
+    string word, candidate;
+#ifdef HW9_STATS
+    stats::LocalCounts counts;
+#endif
+};
+
+// 沿字典树枚举邻居，只会碰到词典里存在的单词，不构造候选字符串
+class TrieAdjacency {
+public:
+    TrieAdjacency(const WordTrie& trie, const string& start) : trie(trie), start(start) {}
+
+    template <typename F>
+    void successors(int v, F&& f) {
+        const Dictionary& dictionary = trie.dictionary();
+        [[maybe_unused]] uint64_t probes =
+            trie.for_each_successor(v < dictionary.size() ? dictionary.word(v) : string_view(start), f);
+        HW9_LOCAL_COUNT_N(counts, LadderProbes, probes);
+    }
+
+    template <typename F>
+    void predecessors(int v, F&& f) {
+        [[maybe_unused]] uint64_t probes = trie.for_each_predecessor(trie.dictionary().word(v), f);
+        HW9_LOCAL_COUNT_N(counts, LadderProbes, probes);
+    }
+
+private:
+    const WordTrie& trie;
+    const string& start;
+#ifdef HW9_STATS
+    stats::LocalCounts counts;
+#endif
+};
+
+// 预先建好的邻接图；只有不在词典中的起点需要试探字符串
+class IndexAdjacency {
+public:
+    IndexAdjacency(const WordIndex& index, const string& start) : index(index), probe(index.dictionary, start) {}
+
+    template <typename F>
+    void successors(int v, F&& f) {
+        if (v < index.graph.num_words()) {
+            for (int w : index.graph.neighbors(v))
+                f(w);
+        } else {
+            probe.successors(v, f);
+        }
+    }
+
+    template <typename F>
+    void predecessors(int v, F&& f) {
+        for (int w : index.graph.predecessors(v))
+            f(w);
+    }
+
+private:
+    const WordIndex& index;
+    ProbeAdjacency probe;
+};
+
+// 双向 BFS，每次展开较小的一侧，只记录每个单词在两侧的层数。
+//
+// 原来的优先队列按 (长度, 最后一个单词) 出队，等价于逐层 BFS、每层按字典序展开，
+// 所以第 k 层单词 v 的前驱是第 k-1 层里能到达 v 的字典序最小的单词。还原时从终点往回，
+// 每一步取满足该条件的最小 ID 前驱，得到的梯子与原来的完全相同，但没有深度限制。
+//
+// 两侧相遇时正向第 0..a 层和反向第 0..b 层都是完整的，最短距离 d = a + b + 1。
+// 距离起点不超过 a 的单词层数已知；更远的最短路层 P_j 从正向边界 F_a 出发，
+// 只沿着反向层数为 d - j 的单词向前推出。
+//
+// max_distance >= 0 时是最短距离的已知上界：两侧层数之和达到它还没相遇，就不会再相遇
+template <typename Adjacency>
+vector<string> bidirectional_ladder(const Dictionary& dictionary, Adjacency& adj, const string& start,
+                                    int start_id, int end_id, LadderSearchState& state, int max_distance = -1) {
+    HW9_LOCAL_COUNTS(counts);
+    int n = dictionary.size();
+    int source = start_id >= 0 ? start_id : n;
+    state.start(n + 1);
+    state.set_forward_level(source, 0);
+    state.set_backward_level(end_id, 0);
+    state.forward.push_back(source);
+    state.backward.push_back(end_id);
+
+    int a = 0, b = 0;
+    bool met = false;
+    while (!met && !state.forward.empty() && !state.backward.empty()) {
+        if (max_distance >= 0 && a + b >= max_distance)
+            return {};
+        bool forward = state.forward.size() <= state.backward.size();
+        state.next.clear();
+        if (forward) {
+            for (size_t i = 0; i < state.forward.size() && !met; ++i) {
+                adj.successors(state.forward[i], [&](int v) {
+                    HW9_LOCAL_COUNT(counts, LadderCandidates);
+                    if (state.forward_level(v) >= 0) {
+                        HW9_LOCAL_COUNT(counts, LadderVisitedHits);
+                        return;
+                    }
+                    state.set_forward_level(v, a + 1);
+                    met = met || state.backward_level(v) >= 0;
+                    state.next.push_back(v);
+                });
+            }
+        } else {
+            for (size_t i = 0; i < state.backward.size() && !met; ++i) {
+                adj.predecessors(state.backward[i], [&](int v) {
+                    HW9_LOCAL_COUNT(counts, LadderCandidates);
+                    if (state.backward_level(v) >= 0) {
+                        HW9_LOCAL_COUNT(counts, LadderVisitedHits);
+                        return;
+                    }
+                    state.set_backward_level(v, b + 1);
+                    met = met || state.forward_level(v) >= 0;
+                    state.next.push_back(v);
+                });
+            }
+        }
+        if (met) break;
+        if (forward) {
+            state.forward.swap(state.next);
+            ++a;
+        } else {
+            state.backward.swap(state.next);
+            ++b;
+        }
+    }
+    if (!met) return {};
+
+    int d = a + b + 1;
+    vector<int>& layer = state.backward;
+    layer.clear();
+    for (int u : state.forward) {
+        adj.successors(u, [&](int v) {
+            if (state.backward_level(v) == d - a - 1 && state.path_level(v) < 0) {
+                state.set_path_level(v, a + 1);
+                layer.push_back(v);
+            }
+        });
+    }
+    for (int j = a + 1; j < d - 1; ++j) {
+        state.next.clear();
+        for (int u : layer) {
+            adj.successors(u, [&](int v) {
+                if (state.backward_level(v) == d - j - 1 && state.path_level(v) < 0) {
+                    state.set_path_level(v, j + 1);
+                    state.next.push_back(v);
+                }
+            });
+        }
+        layer.swap(state.next);
+    }
+
+    vector<string> ladder(d + 1);
+    HW9_COUNT_N(LadderWordsCopied, d + 1);
+    int v = end_id;
+    ladder[d] = dictionary.word(end_id);
+    for (int k = d; k >= 2; --k) {
+        int best = n;
+        adj.predecessors(v, [&](int u) {
+            int level = k - 1 <= a ? state.forward_level(u) : state.path_level(u);
+            if (level == k - 1)
+                best = min(best, u);
+        });
+        v = best;
+        ladder[k - 1] = dictionary.word(v);
+    }
+    ladder[0] = start_id >= 0 ? string(dictionary.word(start_id)) : start;
+    return ladder;
+}
+
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const Dictionary& dictionary,
+                                    LadderSearchState& state) {
+    HW9_TIMER(LadderSearch);
     // 将输入的单词转换为小写以便进行比较
     string start = begin_word;
     string end = end_word;
@@ -87,80 +310,97 @@ vector<string> generate_word_ladder(const string& begin_word, const string& end_
     
     if (start == end) return {};
     
-    if (word_list.find(end) == word_list.end()) {
+    int end_id = dictionary.find(end);
+    if (end_id < 0) {
         return {};
     }
     
-    // 使用优先级队列确保最短路径
-    auto compare = [](const vector<string>& a, const vector<string>& b) {
-        if (a.size() != b.size()) {
-            return a.size() > b.size();
-        }
-        return a.back() > b.back();
-    };
-    
-    priority_queue<vector<string>, vector<vector<string>>, decltype(compare)> ladder_queue(compare);
-    set<string> visited;
-    
-    ladder_queue.push({start});
-    visited.insert(start);
-    
-    const int MAX_DEPTH = 20;
-    
-    while (!ladder_queue.empty()) {
-        vector<string> current_ladder = ladder_queue.top();
-        ladder_queue.pop();
-        
-        if (current_ladder.size() >= MAX_DEPTH) continue;
-        
-        string last_word = current_ladder.back();
-        
-        if (last_word == end) {
-            return current_ladder;
-        }
-        
-        // 尝试改变一个字母
-        for (size_t i = 0; i < last_word.length(); i++) {
-            string new_word = last_word;
-            for (char c = 'a'; c <= 'z'; c++) {
-                new_word[i] = c;
-                if (word_list.find(new_word) != word_list.end() && visited.find(new_word) == visited.end()) {
-                    visited.insert(new_word);
-                    vector<string> new_ladder = current_ladder;
-                    new_ladder.push_back(new_word);
-                    ladder_queue.push(new_ladder);
-                }
-            }
-        }
-        
-        // 尝试插入一个字母
-        for (size_t i = 0; i <= last_word.length(); i++) {
-            for (char c = 'a'; c <= 'z'; c++) {
-                string new_word = last_word;
-                new_word.insert(i, 1, c);
-                if (word_list.find(new_word) != word_list.end() && visited.find(new_word) == visited.end()) {
-                    visited.insert(new_word);
-                    vector<string> new_ladder = current_ladder;
-                    new_ladder.push_back(new_word);
-                    ladder_queue.push(new_ladder);
-                }
-            }
+    ProbeAdjacency adj(dictionary, start);
+    return bidirectional_ladder(dictionary, adj, start, dictionary.find(start), end_id, state);
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordTrie& trie,
+                                    LadderSearchState& state) {
+    HW9_TIMER(LadderSearch);
+    string start = begin_word;
+    string end = end_word;
+    transform(start.begin(), start.end(), start.begin(), ::tolower);
+    transform(end.begin(), end.end(), end.begin(), ::tolower);
+    
+    if (start == end) return {};
+    
+    int end_id = trie.find(end);
+    if (end_id < 0) {
+        return {};
+    }
+    
+    TrieAdjacency adj(trie, start);
+    return bidirectional_ladder(trie.dictionary(), adj, start, trie.find(start), end_id, state);
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordIndex& index,
+                                    LadderSearchState& state) {
+    HW9_TIMER(LadderSearch);
+    string start = begin_word;
+    string end = end_word;
+    transform(start.begin(), start.end(), start.begin(), ::tolower);
+    transform(end.begin(), end.end(), end.begin(), ::tolower);
+    
+    if (start == end) return {};
+    
+    int end_id = index.dictionary.find(end);
+    if (end_id < 0) {
+        return {};
+    }
+    
+    IndexAdjacency adj(index, start);
+    int start_id = index.dictionary.find(start);
+    int max_distance = -1;
+    const WordComponents& components = index.components;
+    if (components.num_words() != index.dictionary.size())
+        throw runtime_error("Word components do not match dictionary");
+    if (start_id >= 0) {
+        if (!components.may_reach(start_id, end_id)) {
+            HW9_COUNT(LadderRejected);
+            return {};
         }
-        
-        // 尝试删除一个字母
-        for (size_t i = 0; i < last_word.length(); i++) {
-            string new_word = last_word;
-            new_word.erase(i, 1);
-            if (word_list.find(new_word) != word_list.end() && visited.find(new_word) == visited.end()) {
-                visited.insert(new_word);
-                vector<string> new_ladder = current_ladder;
-                new_ladder.push_back(new_word);
-                ladder_queue.push(new_ladder);
-            }
+        max_distance = components.distance_bound(start_id, end_id);
+    } else {
+        // 不在词典中的起点只能经过它一步能到的单词，上界取这些单词中已知上界最小的一个再加一步
+        bool reachable = false;
+        adj.successors(index.dictionary.size(), [&](int v) {
+            if (!components.may_reach(v, end_id))
+                return;
+            reachable = true;
+            int b = components.distance_bound(v, end_id);
+            if (b >= 0 && (max_distance < 0 || b + 1 < max_distance))
+                max_distance = b + 1;
+        });
+        if (!reachable) {
+            HW9_COUNT(LadderRejected);
+            return {};
         }
     }
-    
-    return {}; 
+    return bidirectional_ladder(index.dictionary, adj, start, start_id, end_id, state, max_distance);
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const Dictionary& dictionary) {
+    LadderSearchState state;
+    return generate_word_ladder(begin_word, end_word, dictionary, state);
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordTrie& trie) {
+    LadderSearchState state;
+    return generate_word_ladder(begin_word, end_word, trie, state);
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordIndex& index) {
+    LadderSearchState state;
+    return generate_word_ladder(begin_word, end_word, index, state);
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const set<string>& word_list) {
+    return generate_word_ladder(begin_word, end_word, Dictionary::from(word_list));
 }
 
 void print_word_ladder(const vector<string>& ladder) {
@@ -176,7 +416,7 @@ void print_word_ladder(const vector<string>& ladder) {
     cout << " \n";  // 换行符前的空格与预期输出相匹配
 }
 
-void verify_word_ladder() {
+void verify_word_ladder(bool write_cache) {
     string start_word, end_word;
     
     cout << "Enter start word: ";
@@ -195,22 +435,31 @@ void verify_word_ladder() {
         return;
     }
     
-    // 加载词典
-    set<string> dictionary;
+    // 有最新的 words.txt.idx 时直接映射；没有时只回答这一个查询，直接在词典上搜索比先建整个索引快，
+    // 只有要求写缓存时才建索引
+    WordIndex index;
+    Dictionary dictionary;
+    bool indexed = false;
     try {
-        load_words(dictionary, "words.txt");
+        if (write_cache) {
+            load_word_index_cached("words.txt", index, true);
+            indexed = true;
+        } else if (!(indexed = load_fresh_word_index("words.txt", index))) {
+            load_words(dictionary, "words.txt");
+        }
     } catch (const runtime_error& e) {
         cout << "Error: " << e.what() << endl;
         return;
     }
     
     // 验证结束词是否在词典中
-    if (dictionary.find(end_word) == dictionary.end()) {
+    if (!(indexed ? index.dictionary : dictionary).contains(end_word)) {
         error(start_word, end_word, "End word not found in dictionary");
         return;
     }
     
     // 生成并打印梯子
-    vector<string> ladder = generate_word_ladder(start_word, end_word, dictionary);
+    vector<string> ladder = indexed ? generate_word_ladder(start_word, end_word, index)
+                                    : generate_word_ladder(start_word, end_word, dictionary);
     print_word_ladder(ladder);
 }
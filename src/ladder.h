@@ -1,3 +1,5 @@
+#pragma once
+
 #include <iostream>
 #include <fstream>
 #include <queue>
@@ -6,13 +8,37 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <algorithm>
+
+#include "dictionary.h"
+#include "edit_distance.h"
+#include "word_index.h"
+#include "word_trie.h"
+#include "ladder_search.h"
 
 using namespace std;
 
 void error(string word1, string word2, string msg);
 bool edit_distance_within(const std::string& str1, const std::string& str2, int d);
 bool is_adjacent(const string& word1, const string& word2);
+// 最短梯子中按字典序逐步比较最小的一个（起点不必在词典中）；找不到时返回空
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const Dictionary& dictionary);
+// 保留原来的接口，只适合一次性查询：每次调用都要从 word_list 重新构造一个 Dictionary，对整个 words.txt 这比一次搜索本身还慢；
+// 多次查询请先构造 Dictionary、WordTrie 或 WordIndex，再调用对应的版本
 vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const set<string>& word_list);
+// 结果与上面相同。WordTrie 沿字典树只枚举存在的邻居，不需要预先建邻接图，构造一次可以回答多个查询；
+// WordIndex 在预先建好的邻接图上只做整数 BFS，它的连通分量与词典大小不一致时抛出 runtime_error
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordTrie& trie);
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordIndex& index);
+// 复用 state 的版本，适合连续回答大量查询
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const Dictionary& dictionary,
+                                    LadderSearchState& state);
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordTrie& trie,
+                                    LadderSearchState& state);
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordIndex& index,
+                                    LadderSearchState& state);
 void load_words(set<string> & word_list, const string& file_name);
 void print_word_ladder(const vector<string>& ladder);
-void verify_word_ladder();
+// 交互式读入一对单词。有最新的索引缓存时映射它，否则直接在词典上搜索；
+// write_cache 为 true 时改为建索引并把缓存写到当前目录（见 load_word_index_cached）
+void verify_word_ladder(bool write_cache = false);
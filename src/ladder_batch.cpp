@@ -0,0 +1,56 @@
+#include "ladder_batch.h"
+
+vector<vector<string>> batch_word_ladders(const WordIndex& index, const vector<pair<string, string>>& queries,
+                                          ThreadPool& pool) {
+    vector<vector<string>> ladders(queries.size());
+    vector<LadderSearchState> states(pool.size());
+    pool.run(static_cast<int>(queries.size()), [&](int task, int worker) {
+        ladders[task] = generate_word_ladder(queries[task].first, queries[task].second, index, states[worker]);
+    });
+    return ladders;
+}
+
+vector<vector<string>> batch_word_ladders(const WordIndex& index, const vector<pair<string, string>>& queries,
+                                          int threads) {
+    ThreadPool pool(threads);
+    return batch_word_ladders(index, queries, pool);
+}
+
+void write_word_ladder(BufferedWriter& out, const vector<string>& ladder) {
+    if (ladder.empty()) {
+        out.write("No word ladder found.\n");
+        return;
+    }
+    out.write("Word ladder found:");
+    for (const auto& word : ladder) {
+        out.put(' ');
+        out.write(word);
+    }
+    out.write(" \n");
+}
+
+long long answer_ladder_queries(const WordIndex& index, istream& in, ostream& out, ThreadPool& pool, size_t chunk) {
+    BufferedWriter writer(out);
+    vector<LadderSearchState> states(pool.size());
+    vector<pair<string, string>> queries;
+    vector<vector<string>> ladders;
+    long long answered = 0;
+    string start, end;
+    bool more = true;
+    while (more) {
+        queries.clear();
+        while (queries.size() < chunk && (more = static_cast<bool>(in >> start >> end)))
+            queries.emplace_back(std::move(start), std::move(end));
+
+        // 任务只写自己的槽位，写出时再按输入顺序遍历
+        ladders.resize(queries.size());
+        pool.run(static_cast<int>(queries.size()), [&](int task, int worker) {
+            ladders[task] = generate_word_ladder(queries[task].first, queries[task].second, index, states[worker]);
+        });
+        for (size_t i = 0; i < queries.size(); ++i)
+            write_word_ladder(writer, ladders[i]);
+        answered += queries.size();
+    }
+    writer.flush();
+    return answered;
+}
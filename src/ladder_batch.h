@@ -0,0 +1,21 @@
+#pragma once
+
+#include "ladder.h"
+#include "buffered_writer.h"
+#include "thread_pool.h"
+
+// 批量回答单词梯子查询。共享只读的 WordIndex，每个查询是线程池中的一个任务；
+// 每个线程持有自己的 LadderSearchState，在查询之间只递增 epoch 而不重新分配
+
+// ladders[i] 是 queries[i] 的结果，与 generate_word_ladder 相同
+vector<vector<string>> batch_word_ladders(const WordIndex& index, const vector<pair<string, string>>& queries,
+                                          ThreadPool& pool);
+vector<vector<string>> batch_word_ladders(const WordIndex& index, const vector<pair<string, string>>& queries,
+                                          int threads = 0);
+
+// 从 in 中按“起点 终点”成对读取单词，每次取 chunk 个查询并行求解，按输入顺序逐行写出，
+// 每行的格式与 print_word_ladder 相同。返回回答的查询数；最后落单的单词被忽略
+long long answer_ladder_queries(const WordIndex& index, istream& in, ostream& out, ThreadPool& pool,
+                                size_t chunk = 1 << 14);
+
+void write_word_ladder(BufferedWriter& out, const vector<string>& ladder);
@@ -1,6 +1,60 @@
 #include "ladder.h"
+#include "ladder_batch.h"
+#include "stats.h"
 
-int main() {
-    verify_word_ladder();
+// ladder_main [--cache] [--stats]                交互式读入一对单词，与原来相同
+// ladder_main --batch [file] [--threads N] [--words words.txt] [--cache] [--stats]
+//   从文件（省略时为标准输入）成对读取“起点 终点”，词典只加载一次，多线程求解后按输入顺序
+//   每个查询输出一行，格式与交互式相同
+// --cache 把重建的邻接索引写到词典旁边的 .idx 文件，之后的运行直接映射；不给时只读取已有的缓存
+// --stats 在结束时把计数器和计时器以 JSON 写到标准错误
+int main(int argc, char* argv[]) {
+    try {
+        string input, words = "words.txt";
+        int threads = 0;
+        bool batch = false, print_stats = false, write_cache = false, batch_options = false;
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            auto value = [&]() -> string {
+                if (i + 1 >= argc)
+                    throw runtime_error("Missing value for " + arg);
+                batch_options = true;
+                return argv[++i];
+            };
+            if (arg == "--batch") batch = true;
+            else if (arg == "--stats") print_stats = true;
+            else if (arg == "--cache") write_cache = true;
+            else if (arg == "--threads") threads = stoi(value());
+            else if (arg == "--words") words = value();
+            else if (batch && input.empty() && arg[0] != '-') input = arg;
+            else throw runtime_error("Unknown option " + arg);
+        }
+        if (!batch && batch_options)
+            throw runtime_error("Usage: " + string(argv[0]) + " [--batch [file] [--threads N] [--words FILE]] [--cache] [--stats]");
+
+        if (!batch) {
+            verify_word_ladder(write_cache);
+        } else {
+            ios::sync_with_stdio(false);
+            WordIndex index;
+            load_word_index_cached(words, index, write_cache);
+            ThreadPool pool(threads);
+            if (input.empty()) {
+                answer_ladder_queries(index, cin, cout, pool);
+            } else {
+                ifstream in(input);
+                if (!in)
+                    throw runtime_error("Can't open input file");
+                answer_ladder_queries(index, in, cout, pool);
+            }
+        }
+        if (print_stats) {
+            cout.flush();
+            stats::write_json(cerr);
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
     return 0;
 }
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// 可重复使用的单词梯子搜索状态。与 SearchSpace 一样按 epoch 打标记，start() 只递增 epoch，
+// 单次查询的代价只与实际访问的单词数有关。顶点 0..n-2 是单词 ID，n-1 留给不在词典中的起点。
+// 每个顶点记录正向 BFS 层数、反向 BFS 层数，以及还原梯子时它所在的最短路层
+class LadderSearchState {
+public:
+    void start(int n) {
+        if (static_cast<int>(forwardLevel.size()) != n) {
+            forwardLevel.assign(n, 0);
+            backwardLevel.assign(n, 0);
+            pathLevel.assign(n, 0);
+            forwardStamp.assign(n, 0);
+            backwardStamp.assign(n, 0);
+            pathStamp.assign(n, 0);
+            epoch = 0;
+        }
+        if (++epoch == 0) {
+            fill(forwardStamp.begin(), forwardStamp.end(), 0);
+            fill(backwardStamp.begin(), backwardStamp.end(), 0);
+            fill(pathStamp.begin(), pathStamp.end(), 0);
+            epoch = 1;
+        }
+        forward.clear();
+        backward.clear();
+        next.clear();
+    }
+
+    // 未访问时返回 -1
+    int forward_level(int v) const { return forwardStamp[v] == epoch ? forwardLevel[v] : -1; }
+    int backward_level(int v) const { return backwardStamp[v] == epoch ? backwardLevel[v] : -1; }
+    int path_level(int v) const { return pathStamp[v] == epoch ? pathLevel[v] : -1; }
+
+    void set_forward_level(int v, int level) {
+        forwardLevel[v] = level;
+        forwardStamp[v] = epoch;
+    }
+    void set_backward_level(int v, int level) {
+        backwardLevel[v] = level;
+        backwardStamp[v] = epoch;
+    }
+    void set_path_level(int v, int level) {
+        pathLevel[v] = level;
+        pathStamp[v] = epoch;
+    }
+
+    // 两侧当前的边界和正在展开的下一层，跨查询复用容量
+    vector<int> forward;
+    vector<int> backward;
+    vector<int> next;
+
+private:
+    vector<int> forwardLevel;
+    vector<int> backwardLevel;
+    vector<int> pathLevel;
+    vector<uint32_t> forwardStamp;
+    vector<uint32_t> backwardStamp;
+    vector<uint32_t> pathStamp;
+    uint32_t epoch = 0;
+};
@@ -0,0 +1,52 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("Can't open input file");
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw runtime_error("Can't open input file");
+    }
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw runtime_error("Can't map input file");
+        }
+        ::madvise(p, length, MADV_SEQUENTIAL);
+        addr = static_cast<const char*>(p);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (addr)
+        ::munmap(const_cast<char*>(addr), length);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : addr(other.addr), length(other.length) {
+    other.addr = nullptr;
+    other.length = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        if (addr)
+            ::munmap(const_cast<char*>(addr), length);
+        addr = other.addr;
+        length = other.length;
+        other.addr = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
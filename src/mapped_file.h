@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+// 只读内存映射文件，析构时自动解除映射
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const char* data() const { return addr; }
+    size_t size() const { return length; }
+
+private:
+    const char* addr = nullptr;
+    size_t length = 0;
+};
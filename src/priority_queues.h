@@ -0,0 +1,222 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>
+#include <bit>
+
+using namespace std;
+
+// dijkstra_shortest_path<Queue> 使用的优先队列策略。每个队列提供：
+//   reset(n, max_weight)  准备 n 个顶点；max_weight 仅在 needs_max_weight 为真时有意义
+//   push(v, key)          插入 v，或者在 v 已在队列中时降低其键值
+//   pop()                 弹出 (v, key)；惰性队列可能返回过期的条目，由调用者用 visited 跳过
+//   empty()
+
+struct Node {
+    int vertex;
+    int weight;
+    
+    Node(int v, int w) : vertex(v), weight(w) {}
+    
+    bool operator>(const Node& other) const {
+        return weight > other.weight;
+    }
+};
+
+// 原来的实现：每次松弛都压入新条目的二叉堆（惰性删除）
+class LazyBinaryHeap {
+public:
+    static constexpr bool needs_max_weight = false;
+
+    void reset(int /*n*/, int /*max_weight*/ = 0) { pq = {}; }
+    bool empty() const { return pq.empty(); }
+    void push(int v, int key) { pq.push(Node(v, key)); }
+    pair<int, int> pop() {
+        Node top = pq.top();
+        pq.pop();
+        return {top.vertex, top.weight};
+    }
+
+private:
+    priority_queue<Node, vector<Node>, greater<Node>> pq;
+};
+
+// 带位置索引的 D 叉堆，支持真正的 decrease-key，堆大小不超过 V
+template <int D = 4>
+class DaryHeap {
+    static_assert(D >= 2, "DaryHeap needs at least two children per node");
+public:
+    static constexpr bool needs_max_weight = false;
+
+    void reset(int n, int /*max_weight*/ = 0) {
+        if (static_cast<int>(pos.size()) != n) {
+            pos.assign(n, -1);
+            key.assign(n, 0);
+        } else {
+            for (int v : heap)
+                pos[v] = -1;
+        }
+        heap.clear();
+    }
+
+    bool empty() const { return heap.empty(); }
+    bool contains(int v) const { return pos[v] != -1; }
+    int min_key() const { return key[heap.front()]; }
+
+    void push(int v, int k) {
+        if (pos[v] == -1) {
+            key[v] = k;
+            pos[v] = static_cast<int>(heap.size());
+            heap.push_back(v);
+            sift_up(pos[v]);
+        } else if (k < key[v]) {
+            key[v] = k;
+            sift_up(pos[v]);
+        }
+    }
+
+    pair<int, int> pop() {
+        int top = heap.front();
+        int last = heap.back();
+        heap.pop_back();
+        pos[top] = -1;
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last] = 0;
+            sift_down(0);
+        }
+        return {top, key[top]};
+    }
+
+private:
+    void sift_up(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (key[heap[parent]] <= key[v])
+                break;
+            heap[i] = heap[parent];
+            pos[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    void sift_down(int i) {
+        int v = heap[i];
+        int n = static_cast<int>(heap.size());
+        while (true) {
+            int first = i * D + 1;
+            if (first >= n)
+                break;
+            int best = first;
+            for (int c = first + 1; c < first + D && c < n; ++c)
+                if (key[heap[c]] < key[heap[best]])
+                    best = c;
+            if (key[heap[best]] >= key[v])
+                break;
+            heap[i] = heap[best];
+            pos[heap[i]] = i;
+            i = best;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    vector<int> heap;
+    vector<int> pos;
+    vector<int> key;
+};
+
+// 单调基数堆：键值必须非负且不小于上一次弹出的键值（非负权重的 Dijkstra 满足这一点）
+class RadixHeap {
+public:
+    static constexpr bool needs_max_weight = false;
+
+    void reset(int /*n*/, int /*max_weight*/ = 0) {
+        for (auto& b : buckets)
+            b.clear();
+        count = 0;
+        last = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void push(int v, int key) {
+        if (key < 0 || static_cast<uint32_t>(key) < last)
+            throw runtime_error("RadixHeap requires non-negative, monotone keys");
+        buckets[bucket_of(static_cast<uint32_t>(key))].emplace_back(static_cast<uint32_t>(key), v);
+        ++count;
+    }
+
+    pair<int, int> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty())
+                ++i;
+            uint32_t new_last = buckets[i].front().first;
+            for (const auto& e : buckets[i])
+                new_last = min(new_last, e.first);
+            last = new_last;
+            for (const auto& e : buckets[i])
+                buckets[bucket_of(e.first)].push_back(e);
+            buckets[i].clear();
+        }
+        auto e = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+        return {e.second, static_cast<int>(e.first)};
+    }
+
+private:
+    int bucket_of(uint32_t key) const { return key == last ? 0 : 32 - countl_zero(key ^ last); }
+
+    vector<pair<uint32_t, int>> buckets[33];
+    size_t count = 0;
+    uint32_t last = 0;
+};
+
+// Dial 桶队列：max_weight + 1 个循环桶，适合权重范围很小的图
+class DialQueue {
+public:
+    static constexpr bool needs_max_weight = true;
+
+    void reset(int /*n*/, int max_weight) {
+        if (max_weight < 0)
+            throw runtime_error("DialQueue requires non-negative weights");
+        buckets.assign(static_cast<size_t>(max_weight) + 1, {});
+        count = 0;
+        current = 0;
+        current_key = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void push(int v, int key) {
+        if (key < current_key || key - current_key >= static_cast<int>(buckets.size()))
+            throw runtime_error("DialQueue key outside the bucket window");
+        buckets[static_cast<size_t>(key) % buckets.size()].push_back(v);
+        ++count;
+    }
+
+    pair<int, int> pop() {
+        while (buckets[current].empty()) {
+            current = current + 1 == buckets.size() ? 0 : current + 1;
+            ++current_key;
+        }
+        int v = buckets[current].back();
+        buckets[current].pop_back();
+        --count;
+        return {v, current_key};
+    }
+
+private:
+    vector<vector<int>> buckets;
+    size_t count = 0;
+    size_t current = 0;
+    int current_key = 0;
+};
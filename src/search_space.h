@@ -0,0 +1,47 @@
+#pragma once
+
+#include "dijkstras.h"
+
+#include <cstdint>
+
+// 可重复使用的 Dijkstra 搜索状态。数组按 epoch 打标记：start() 只递增 epoch，
+// 不需要把 V 个元素重新填成 INF，因此单次查询的代价只与实际访问的顶点数有关
+class SearchSpace {
+public:
+    void start(int n) {
+        if (static_cast<int>(distance.size()) != n) {
+            distance.assign(n, INF);
+            previous.assign(n, -1);
+            reached.assign(n, 0);
+            closed.assign(n, 0);
+            epoch = 0;
+        }
+        if (++epoch == 0) {
+            fill(reached.begin(), reached.end(), 0);
+            fill(closed.begin(), closed.end(), 0);
+            epoch = 1;
+        }
+        heap.reset(n);
+    }
+
+    int dist(int v) const { return reached[v] == epoch ? distance[v] : INF; }
+    int prev(int v) const { return reached[v] == epoch ? previous[v] : -1; }
+    bool is_reached(int v) const { return reached[v] == epoch; }
+    bool settled(int v) const { return closed[v] == epoch; }
+
+    void update(int v, int d, int p) {
+        distance[v] = d;
+        previous[v] = p;
+        reached[v] = epoch;
+    }
+    void settle(int v) { closed[v] = epoch; }
+
+    DaryHeap<4> heap;
+
+private:
+    vector<int> distance;
+    vector<int> previous;
+    vector<uint32_t> reached;
+    vector<uint32_t> closed;
+    uint32_t epoch = 0;
+};
@@ -0,0 +1,190 @@
+#include "shortest_path.h"
+
+#include <cmath>
+
+CSRGraph reverse_graph(const CSRGraph& G) {
+    int n = G.num_vertices();
+    vector<int> offsets(n + 1, 0);
+    for (int i = 0; i < G.num_edges(); ++i)
+        ++offsets[G.edge_dst(i) + 1];
+    for (int u = 0; u < n; ++u)
+        offsets[u + 1] += offsets[u];
+
+    vector<int> dst(G.num_edges()), weight(G.num_edges());
+    vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for_each_edge(G, u, [&](int v, int w) {
+            int i = next[v]++;
+            dst[i] = u;
+            weight[i] = w;
+        });
+    }
+    return CSRGraph(n, std::move(offsets), std::move(dst), std::move(weight));
+}
+
+Heuristic euclidean_heuristic(const vector<Point>& coords, int target, double cost_per_unit) {
+    return [&coords, target, cost_per_unit](int v) {
+        double dx = coords[v].x - coords[target].x;
+        double dy = coords[v].y - coords[target].y;
+        return static_cast<int>(floor(sqrt(dx * dx + dy * dy) * cost_per_unit));
+    };
+}
+
+PathQuery::PathQuery(CSRGraph G) : forward(std::move(G)) {}
+
+// meet 是正向与反向前驱链的交汇点；反向搜索的前驱指向离 target 更近的顶点
+void PathQuery::check_vertices(int source, int target) const {
+    int n = forward.num_vertices();
+    if (source < 0 || source >= n || target < 0 || target >= n)
+        throw runtime_error("Vertex out of range");
+}
+
+PathResult PathQuery::unpack(int target, int meet, int cost) const {
+    PathResult result;
+    if (meet == -1)
+        return result;
+    result.cost = cost;
+    for (int at = meet; at != -1; at = fwd.prev(at))
+        result.path.push_back(at);
+    reverse(result.path.begin(), result.path.end());
+    if (meet != target)
+        for (int at = bwd.prev(meet); at != -1; at = bwd.prev(at))
+            result.path.push_back(at);
+    return result;
+}
+
+PathResult PathQuery::early_exit(int source, int target) {
+    check_vertices(source, target);
+    HW9_TIMER(DijkstraSearch);
+    HW9_LOCAL_COUNTS(counts);
+    fwd.start(forward.num_vertices());
+    fwd.update(source, 0, -1);
+    fwd.heap.push(source, 0);
+    HW9_LOCAL_COUNT(counts, DijkstraPushes);
+
+    while (!fwd.heap.empty()) {
+        int u = fwd.heap.pop().first;
+        HW9_LOCAL_COUNT(counts, DijkstraPops);
+        fwd.settle(u);
+        if (u == target)
+            return unpack(target, target, fwd.dist(target));
+        int du = fwd.dist(u);
+        for_each_edge(forward, u, [&](int v, int w) {
+            HW9_LOCAL_COUNT(counts, DijkstraRelaxations);
+            if (!fwd.settled(v) && du + w < fwd.dist(v)) {
+                fwd.update(v, du + w, u);
+                fwd.heap.push(v, du + w);
+                HW9_LOCAL_COUNT(counts, DijkstraPushes);
+            }
+        });
+    }
+    return {};
+}
+
+PathResult PathQuery::bidirectional(int source, int target) {
+    check_vertices(source, target);
+    if (!hasBackward) {
+        backward = reverse_graph(forward);
+        hasBackward = true;
+    }
+    HW9_TIMER(DijkstraSearch);
+    HW9_LOCAL_COUNTS(counts);
+    int n = forward.num_vertices();
+    fwd.start(n);
+    bwd.start(n);
+    fwd.update(source, 0, -1);
+    fwd.heap.push(source, 0);
+    bwd.update(target, 0, -1);
+    bwd.heap.push(target, 0);
+    HW9_LOCAL_COUNT_N(counts, DijkstraPushes, 2);
+
+    int best = INF;
+    int meet = -1;
+    if (source == target) {
+        best = 0;
+        meet = source;
+    }
+
+    // 两个方向的最小键之和不小于当前最优值时，不可能再找到更短的路径
+    while (!fwd.heap.empty() && !bwd.heap.empty()
+           && static_cast<long long>(fwd.heap.min_key()) + bwd.heap.min_key() < best) {
+        bool forward_step = fwd.heap.min_key() <= bwd.heap.min_key();
+        SearchSpace& self = forward_step ? fwd : bwd;
+        SearchSpace& other = forward_step ? bwd : fwd;
+        const CSRGraph& G = forward_step ? forward : backward;
+
+        int u = self.heap.pop().first;
+        HW9_LOCAL_COUNT(counts, DijkstraPops);
+        self.settle(u);
+        int du = self.dist(u);
+        for_each_edge(G, u, [&](int v, int w) {
+            HW9_LOCAL_COUNT(counts, DijkstraRelaxations);
+            if (self.settled(v) || du + w >= self.dist(v))
+                return;
+            self.update(v, du + w, u);
+            self.heap.push(v, du + w);
+            HW9_LOCAL_COUNT(counts, DijkstraPushes);
+            if (other.is_reached(v) && static_cast<long long>(du) + w + other.dist(v) < best) {
+                best = du + w + other.dist(v);
+                meet = v;
+            }
+        });
+    }
+    return unpack(target, meet, best);
+}
+
+PathResult PathQuery::astar(int source, int target, const Heuristic& heuristic) {
+    check_vertices(source, target);
+    HW9_TIMER(DijkstraSearch);
+    HW9_LOCAL_COUNTS(counts);
+    fwd.start(forward.num_vertices());
+    int h = heuristic(source);
+    if (h == INF)
+        return {};
+    fwd.update(source, 0, -1);
+    fwd.heap.push(source, h);
+    HW9_LOCAL_COUNT(counts, DijkstraPushes);
+
+    // 启发函数只要求可采纳而不一定一致，因此允许已弹出的顶点在 g 值变小时重新入堆
+    while (!fwd.heap.empty()) {
+        int u = fwd.heap.pop().first;
+        HW9_LOCAL_COUNT(counts, DijkstraPops);
+        if (u == target)
+            return unpack(target, target, fwd.dist(target));
+        int gu = fwd.dist(u);
+        for_each_edge(forward, u, [&](int v, int w) {
+            HW9_LOCAL_COUNT(counts, DijkstraRelaxations);
+            if (gu + w >= fwd.dist(v))
+                return;
+            int hv = heuristic(v);
+            if (hv == INF)
+                return;
+            fwd.update(v, gu + w, u);
+            fwd.heap.push(v, gu + w + hv);
+            HW9_LOCAL_COUNT(counts, DijkstraPushes);
+        });
+    }
+    return {};
+}
+
+PathResult PathQuery::run(int source, int target, const QueryOptions& options) {
+    switch (options.mode) {
+    case QueryMode::Bidirectional:
+        return bidirectional(source, target);
+    case QueryMode::AStar:
+        if (!options.heuristic)
+            throw runtime_error("A* query requires a heuristic");
+        return astar(source, target, options.heuristic);
+    case QueryMode::EarlyExit:
+        break;
+    }
+    return early_exit(source, target);
+}
+
+PathResult shortest_path(const CSRGraph& G, int source, int target, const QueryOptions& options) {
+    return PathQuery(G).run(source, target, options);
+}
+
+PathResult shortest_path(const Graph& G, int source, int target, const QueryOptions& options) {
+    return PathQuery(CSRGraph(G)).run(source, target, options);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "dijkstras.h"
+#include "search_space.h"
+
+#include <functional>
+
+// 单源单汇查询的结果；不可达时 path 为空且 cost 为 INF
+struct PathResult {
+    vector<int> path;
+    int cost = INF;
+};
+
+enum class QueryMode {
+    EarlyExit,      // 普通 Dijkstra，目标被确定后立即停止
+    Bidirectional,  // 从 s 正向、从 t 在反向图上同时搜索
+    AStar           // 用可采纳的启发函数引导的 A*
+};
+
+// heuristic(v) 必须是 v 到目标距离的下界（可采纳）；返回 INF 表示 v 不可能到达目标
+using Heuristic = function<int(int)>;
+
+struct QueryOptions {
+    QueryMode mode = QueryMode::EarlyExit;
+    Heuristic heuristic;
+};
+
+// 边全部反向的图，供双向搜索的后向部分使用
+CSRGraph reverse_graph(const CSRGraph& G);
+
+// 平面坐标的欧氏距离乘以每单位距离的最小代价，向下取整；
+// 当每条边的权重都不小于其两端点距离 * cost_per_unit 时是可采纳的；coords 按引用捕获
+struct Point {
+    double x = 0;
+    double y = 0;
+};
+Heuristic euclidean_heuristic(const vector<Point>& coords, int target, double cost_per_unit = 1.0);
+
+// 对同一张图重复查询的引擎：反向图在第一次双向查询时构建一次，搜索状态在查询之间复用
+class PathQuery {
+public:
+    explicit PathQuery(CSRGraph G);
+
+    PathResult early_exit(int source, int target);
+    PathResult bidirectional(int source, int target);
+    PathResult astar(int source, int target, const Heuristic& heuristic);
+    PathResult run(int source, int target, const QueryOptions& options = {});
+
+    const CSRGraph& graph() const { return forward; }
+
+private:
+    // 源点或目标点不在 [0, n) 内时抛出 runtime_error
+    void check_vertices(int source, int target) const;
+    PathResult unpack(int target, int meet, int cost) const;
+
+    CSRGraph forward;
+    CSRGraph backward;
+    bool hasBackward = false;
+    SearchSpace fwd;
+    SearchSpace bwd;
+};
+
+// 一次性查询；需要反复查询同一张图时请使用 PathQuery
+PathResult shortest_path(const CSRGraph& G, int source, int target, const QueryOptions& options = {});
+PathResult shortest_path(const Graph& G, int source, int target, const QueryOptions& options = {});
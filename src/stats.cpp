@@ -0,0 +1,89 @@
+#include "stats.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace stats {
+
+namespace {
+atomic<uint64_t> totals[NUM_COUNTERS];
+atomic<uint64_t> timer_calls[NUM_TIMERS];
+atomic<uint64_t> timer_nanos[NUM_TIMERS];
+
+const char* const COUNTER_NAMES[NUM_COUNTERS] = {
+    "dijkstra_pushes",
+    "dijkstra_pops",
+    "dijkstra_stale_pops",
+    "dijkstra_relaxations",
+    "ladder_probes",
+    "ladder_candidates",
+    "ladder_visited_hits",
+    "ladder_rejected",
+    "ladder_words_copied",
+};
+
+const char* const TIMER_NAMES[NUM_TIMERS] = {
+    "dijkstra_search",
+    "ladder_search",
+    "file_to_graph",
+    "load_words",
+};
+}
+
+void flush() {
+    for (int c = 0; c < NUM_COUNTERS; ++c) {
+        if (local_counts[c]) {
+            totals[c].fetch_add(local_counts[c], memory_order_relaxed);
+            local_counts[c] = 0;
+        }
+    }
+}
+
+void record(Timer t, chrono::steady_clock::duration elapsed) {
+    int i = static_cast<int>(t);
+    timer_calls[i].fetch_add(1, memory_order_relaxed);
+    timer_nanos[i].fetch_add(chrono::duration_cast<chrono::nanoseconds>(elapsed).count(), memory_order_relaxed);
+}
+
+Snapshot snapshot() {
+    flush();
+    Snapshot s;
+    for (int c = 0; c < NUM_COUNTERS; ++c)
+        s.counters[c] = totals[c].load(memory_order_relaxed);
+    for (int t = 0; t < NUM_TIMERS; ++t)
+        s.timers[t] = {timer_calls[t].load(memory_order_relaxed), timer_nanos[t].load(memory_order_relaxed)};
+    return s;
+}
+
+void reset() {
+    fill(begin(local_counts), end(local_counts), 0);
+    for (auto& c : totals)
+        c.store(0, memory_order_relaxed);
+    for (int t = 0; t < NUM_TIMERS; ++t) {
+        timer_calls[t].store(0, memory_order_relaxed);
+        timer_nanos[t].store(0, memory_order_relaxed);
+    }
+}
+
+const char* name(Counter c) {
+    return COUNTER_NAMES[static_cast<int>(c)];
+}
+
+const char* name(Timer t) {
+    return TIMER_NAMES[static_cast<int>(t)];
+}
+
+void write_json(ostream& out) {
+    Snapshot s = snapshot();
+    out << "{\"enabled\": " << (enabled ? "true" : "false") << ", \"counters\": {";
+    for (int c = 0; c < NUM_COUNTERS; ++c)
+        out << (c ? ", " : "") << "\"" << COUNTER_NAMES[c] << "\": " << s.counters[c];
+    out << "}, \"timers\": {";
+    for (int t = 0; t < NUM_TIMERS; ++t) {
+        out << (t ? ", " : "") << "\"" << TIMER_NAMES[t] << "\": {\"calls\": " << s.timers[t].calls
+            << ", \"total_ms\": " << s.timers[t].nanos / 1e6 << "}";
+    }
+    out << "}}\n";
+}
+
+}
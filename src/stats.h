@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+using namespace std;
+
+// 热路径上的计数器和计时器，用来比较不同实现、发现性能回退。
+// 只有定义了 HW9_STATS（CMake 选项 HW9_STATS，默认打开）时下面的宏才会展开，否则什么也不做，
+// 参数也不会被求值。
+//
+// 计数先加到当前线程自己的数组里，热循环中只是一次普通的自增；HW9_TIMER 的作用域结束时
+// 再把本线程的计数汇总到全局，所以所有计数都应该放在某个计时作用域内
+namespace stats {
+
+enum class Counter {
+    DijkstraPushes,       // 入队次数（点对点查询中减小已在堆里的键也算一次）
+    DijkstraPops,         // 出队次数
+    DijkstraStalePops,    // 出队时顶点已经确定的次数（惰性删除留下的旧条目）
+    DijkstraRelaxations,  // 检查过的出边数
+    LadderProbes,         // 试探一次编辑：逐个试探时是一次词典查找，字典树上是沿一个分支的匹配
+    LadderCandidates,     // BFS 展开时得到的邻居单词
+    LadderVisitedHits,    // 其中已经在同一侧访问过的
+    LadderRejected,       // 由连通分量直接判定无解的查询
+    LadderWordsCopied,    // 复制到返回的梯子中的单词数
+    Count
+};
+
+enum class Timer {
+    DijkstraSearch,
+    LadderSearch,
+    FileToGraph,
+    LoadWords,
+    Count
+};
+
+constexpr int NUM_COUNTERS = static_cast<int>(Counter::Count);
+constexpr int NUM_TIMERS = static_cast<int>(Timer::Count);
+
+#ifdef HW9_STATS
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+// 常量初始化，访问时不需要检查线程局部变量是否已构造
+inline thread_local uint64_t local_counts[NUM_COUNTERS] = {};
+
+inline void count(Counter c, uint64_t n = 1) {
+    local_counts[static_cast<int>(c)] += n;
+}
+
+// 热循环里的计数：先加到函数自己的局部数组，析构时一次性加到本线程的计数。
+// 局部数组的地址不逃逸，编译器可以把它留在寄存器里，循环中的函数调用不会迫使它写回内存
+class LocalCounts {
+public:
+    LocalCounts() = default;
+    ~LocalCounts() {
+        for (int c = 0; c < NUM_COUNTERS; ++c)
+            local_counts[c] += counts[c];
+    }
+    LocalCounts(const LocalCounts&) = delete;
+    LocalCounts& operator=(const LocalCounts&) = delete;
+
+    void add(Counter c, uint64_t n = 1) { counts[static_cast<int>(c)] += n; }
+
+private:
+    uint64_t counts[NUM_COUNTERS] = {};
+};
+
+// 把当前线程的计数加到全局
+void flush();
+void record(Timer t, chrono::steady_clock::duration elapsed);
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer timer) : timer(timer), begin(chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        record(timer, chrono::steady_clock::now() - begin);
+        flush();
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Timer timer;
+    chrono::steady_clock::time_point begin;
+};
+
+struct TimerTotal {
+    uint64_t calls = 0;
+    uint64_t nanos = 0;
+};
+
+struct Snapshot {
+    uint64_t counters[NUM_COUNTERS] = {};
+    TimerTotal timers[NUM_TIMERS] = {};
+
+    uint64_t operator[](Counter c) const { return counters[static_cast<int>(c)]; }
+    const TimerTotal& operator[](Timer t) const { return timers[static_cast<int>(t)]; }
+};
+
+// 当前的全局计数（先汇总调用线程自己的计数）
+Snapshot snapshot();
+void reset();
+
+const char* name(Counter c);
+const char* name(Timer t);
+
+// {"enabled": ..., "counters": {...}, "timers": {"name": {"calls": ..., "total_ms": ...}, ...}}
+void write_json(ostream& out);
+
+}
+
+// HW9_LOCAL_COUNTS(name) 声明一个 LocalCounts，之后在同一作用域里用 HW9_LOCAL_COUNT(name, counter)
+// 或 HW9_LOCAL_COUNT_N(name, counter, n) 计数；要放在 HW9_TIMER 之后声明，这样它先析构，
+// 计数赶得上计时器结束时的汇总。作为类成员时用 #ifdef HW9_STATS 包住 stats::LocalCounts 的声明
+#ifdef HW9_STATS
+#define HW9_COUNT(counter) ::stats::count(::stats::Counter::counter)
+#define HW9_COUNT_N(counter, n) ::stats::count(::stats::Counter::counter, (n))
+#define HW9_TIMER(timer) ::stats::ScopedTimer hw9_stats_timer_##timer(::stats::Timer::timer)
+#define HW9_LOCAL_COUNTS(name) ::stats::LocalCounts name
+#define HW9_LOCAL_COUNT(name, counter) name.add(::stats::Counter::counter)
+#define HW9_LOCAL_COUNT_N(name, counter, n) name.add(::stats::Counter::counter, (n))
+#else
+#define HW9_COUNT(counter) ((void)0)
+#define HW9_COUNT_N(counter, n) ((void)0)
+#define HW9_TIMER(timer) ((void)0)
+#define HW9_LOCAL_COUNTS(name) ((void)0)
+#define HW9_LOCAL_COUNT(name, counter) ((void)0)
+#define HW9_LOCAL_COUNT_N(name, counter, n) ((void)0)
+#endif
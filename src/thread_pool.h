@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// 固定大小的线程池。run() 把 [0, count) 的任务分给所有线程（调用线程也参与），
+// 并阻塞到全部完成；worker 编号在 [0, size()) 内，可用来索引每个线程自己的工作区
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads = 0) {
+        if (threads <= 0)
+            threads = max(1u, thread::hardware_concurrency());
+        for (int w = 1; w < threads; ++w)
+            workers.emplace_back([this, w] { worker_loop(w); });
+    }
+
+    ~ThreadPool() {
+        stopping = true;
+        generation.fetch_add(1);
+        generation.notify_all();
+        for (thread& t : workers)
+            t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    // 返回之前不能再调用 run（包括在任务里嵌套调用或从别的线程并发调用），否则会覆盖 job 和 active 并死锁
+    void run(int count, const function<void(int task, int worker)>& f) {
+        if (count <= 0)
+            return;
+        [[maybe_unused]] bool nested = running.exchange(true);
+        assert(!nested && "ThreadPool::run called again before it returned");
+        job = &f;
+        taskCount = count;
+        nextTask = 0;
+        error = nullptr;
+        active = static_cast<int>(workers.size());
+        generation.fetch_add(1);
+        generation.notify_all();
+        do_tasks(0);
+
+        for (int left = active.load(); left != 0; left = active.load())
+            active.wait(left);
+        job = nullptr;
+        running = false;
+        if (error)
+            rethrow_exception(error);
+    }
+
+private:
+    // 用 atomic wait/notify 等待新任务，而不是 condition_variable
+    void worker_loop(int w) {
+        size_t seen = 0;
+        while (true) {
+            generation.wait(seen);
+            seen = generation.load();
+            if (stopping)
+                return;
+            do_tasks(w);
+            if (active.fetch_sub(1) == 1)
+                active.notify_one();
+        }
+    }
+
+    void do_tasks(int w) {
+        for (int task; (task = nextTask.fetch_add(1)) < taskCount;) {
+            try {
+                (*job)(task, w);
+            } catch (...) {
+                lock_guard<mutex> lock(errorMutex);
+                if (!error)
+                    error = current_exception();
+                nextTask = taskCount;
+            }
+        }
+    }
+
+    vector<thread> workers;
+    const function<void(int, int)>* job = nullptr;
+    int taskCount = 0;
+    atomic<int> nextTask{0};
+    atomic<int> active{0};
+    atomic<size_t> generation{0};
+    atomic<bool> stopping{false};
+    atomic<bool> running{false};
+    mutex errorMutex;
+    exception_ptr error;
+};
@@ -0,0 +1,100 @@
+#include "tree_export.h"
+#include "buffered_writer.h"
+
+#include <cstring>
+
+namespace {
+
+void write_distance(BufferedWriter& w, int d) {
+    if (d == INF)
+        w.write("inf");
+    else
+        w.write_int(d);
+}
+
+// 复用同一个路径缓冲区，整段输出只与路径总长度成正比
+void write_paths(BufferedWriter& w, const ShortestPathTree& tree) {
+    vector<int> path;
+    int n = static_cast<int>(tree.distance.size());
+    for (int v = 0; v < n; ++v) {
+        w.write("\nShortest path from ");
+        w.write_int(tree.source);
+        w.write(" to ");
+        w.write_int(v);
+        w.write(":\n");
+
+        path.clear();
+        if (tree.distance[v] != INF)
+            for (int at = v; at != -1; at = tree.previous[at])
+                path.push_back(at);
+        if (!path.empty()) {
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                w.write_int(*it);
+                w.put(' ');
+            }
+        }
+        w.write("\nTotal cost is ");
+        w.write_int(tree.distance[v]);
+        w.put('\n');
+    }
+}
+
+void write_rows(BufferedWriter& w, const ShortestPathTree& tree, char sep) {
+    int n = static_cast<int>(tree.distance.size());
+    for (int v = 0; v < n; ++v) {
+        w.write_int(v);
+        w.put(sep);
+        write_distance(w, tree.distance[v]);
+        w.put(sep);
+        w.write_int(tree.previous[v]);
+        w.put('\n');
+    }
+}
+
+void write_binary(BufferedWriter& w, const ShortestPathTree& tree) {
+    TreeFileHeader header{};
+    memcpy(header.magic, TREE_FILE_MAGIC, sizeof(header.magic));
+    header.version = TREE_FILE_VERSION;
+    header.numVertices = static_cast<int32_t>(tree.distance.size());
+    header.source = tree.source;
+    w.write_bytes(&header, sizeof(header));
+    w.write_bytes(tree.distance.data(), tree.distance.size() * sizeof(int));
+    w.write_bytes(tree.previous.data(), tree.previous.size() * sizeof(int));
+}
+
+}
+
+void export_shortest_path_tree(ostream& out, const ShortestPathTree& tree, TreeFormat format) {
+    if (tree.distance.size() != tree.previous.size())
+        throw runtime_error("Malformed shortest path tree");
+    BufferedWriter w(out);
+    switch (format) {
+    case TreeFormat::Paths:
+        write_paths(w, tree);
+        break;
+    case TreeFormat::Text:
+        write_rows(w, tree, ' ');
+        break;
+    case TreeFormat::Csv:
+        w.write("vertex,distance,previous\n");
+        write_rows(w, tree, ',');
+        break;
+    case TreeFormat::Binary:
+        write_binary(w, tree);
+        break;
+    }
+    w.flush();
+    out.flush();
+}
+
+TreeFormat parse_tree_format(const string& name) {
+    if (name == "paths")
+        return TreeFormat::Paths;
+    if (name == "text")
+        return TreeFormat::Text;
+    if (name == "csv")
+        return TreeFormat::Csv;
+    if (name == "binary")
+        return TreeFormat::Binary;
+    throw runtime_error("Unknown tree format: " + name);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "dijkstras.h"
+
+enum class TreeFormat {
+    Paths,   // 与 dijkstra_main 原来的输出相同：每个顶点一段 "Shortest path from s to v" 和总代价
+    Text,    // 每行 "vertex distance previous"，不可达的距离写作 inf
+    Csv,     // 表头 vertex,distance,previous，其余同 Text
+    Binary   // TreeFileHeader 后接 int32 distance[n] 与 int32 previous[n]
+};
+
+struct TreeFileHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t numVertices;
+    int32_t source;
+};
+
+constexpr char TREE_FILE_MAGIC[4] = {'H', 'W', '9', 'T'};
+constexpr uint32_t TREE_FILE_VERSION = 1;
+
+// 一次性流式写出整棵最短路径树；源点显式给出，路径只在 Paths 格式中才逐个重建
+void export_shortest_path_tree(ostream& out, const ShortestPathTree& tree, TreeFormat format);
+
+TreeFormat parse_tree_format(const string& name);
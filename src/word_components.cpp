@@ -0,0 +1,119 @@
+#include "word_components.h"
+#include "word_index.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+WordComponents::WordComponents(const Dictionary& dictionary, const WordGraph& graph) {
+    int n = graph.num_words();
+    if (n != dictionary.size())
+        throw runtime_error("Word graph does not match dictionary");
+    vector<int> word_level(n);
+    for (int id = 0; id < n; ++id)
+        word_level[id] = level_of(dictionary.word(id));
+
+    // 层级相同的边是双向的，只沿出边 BFS 就能走遍整个分量
+    label.assign(n, -1);
+    vector<int> distance(n), queue;
+    for (int root = 0; root < n; ++root) {
+        if (label[root] >= 0)
+            continue;
+        int c = count++;
+        label[root] = c;
+        distance[root] = 0;
+        queue.assign(1, root);
+        int eccentricity = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int u = queue[head];
+            eccentricity = distance[u];
+            for (int v : graph.neighbors(u)) {
+                if (label[v] >= 0 || word_level[v] != word_level[u])
+                    continue;
+                label[v] = c;
+                distance[v] = distance[u] + 1;
+                queue.push_back(v);
+            }
+        }
+        int size = static_cast<int>(queue.size());
+        parent.push_back(c);
+        sizes.push_back(size);
+        bounds.push_back(min(2 * eccentricity, size - 1));
+        levels.push_back(word_level[root]);
+    }
+}
+
+WordComponents::WordComponents(span<const int> labels, span<const int> parents, span<const int> sizes,
+                               span<const int> bounds, span<const int> levels)
+    : label(labels.begin(), labels.end()), parent(parents.begin(), parents.end()), sizes(sizes.begin(), sizes.end()),
+      bounds(bounds.begin(), bounds.end()), levels(levels.begin(), levels.end()) {
+    int k = static_cast<int>(parent.size());
+    if (this->sizes.size() != parent.size() || this->bounds.size() != parent.size() || this->levels.size() != parent.size())
+        throw runtime_error("Malformed word components");
+    for (int c : label)
+        if (c < 0 || c >= k)
+            throw runtime_error("Malformed word components");
+    // 根的父节点是自己；沿父节点走超过 k 步说明有环，component() 会死循环
+    for (int c = 0; c < k; ++c) {
+        if (parent[c] < 0 || parent[c] >= k)
+            throw runtime_error("Malformed word components");
+        count += parent[c] == c;
+    }
+    for (int c = 0; c < k; ++c) {
+        int steps = 0;
+        for (int r = c; parent[r] != r; r = parent[r])
+            if (++steps > k)
+                throw runtime_error("Malformed word components");
+    }
+}
+
+int WordComponents::level_of(string_view word) {
+    return static_cast<int>(count_if(word.begin(), word.end(), [](char c) { return c < 'a' || c > 'z'; }));
+}
+
+int WordComponents::add_word(int id, string_view word, span<const int> neighbors) {
+    int n = num_words();
+    if (id < 0 || id > n)
+        throw runtime_error("Word ID out of range");
+    int lvl = level_of(word);
+    vector<int> roots;
+    for (int v : neighbors) {
+        if (v < 0 || v > n || v == id)
+            throw runtime_error("Neighbor is not an existing word");
+        // 插入之前的编号
+        int r = component(v > id ? v - 1 : v);
+        if (levels[r] == lvl && find(roots.begin(), roots.end(), r) == roots.end())
+            roots.push_back(r);
+    }
+
+    int c = static_cast<int>(parent.size());
+    label.insert(label.begin() + id, c);
+    parent.push_back(c);
+    sizes.push_back(1);
+    bounds.push_back(0);
+    levels.push_back(lvl);
+    ++count;
+    if (roots.empty())
+        return c;
+
+    // 新单词到分量 i 中的单词不超过 b_i + 1 步，分量 i 到分量 j 之间经过新单词不超过 b_i + b_j + 2 步
+    int best = -1, second = -1, size = 1;
+    for (int r : roots) {
+        if (bounds[r] > best) {
+            second = best;
+            best = bounds[r];
+        } else if (bounds[r] > second) {
+            second = bounds[r];
+        }
+        size += sizes[r];
+    }
+    int bound = second < 0 ? best + 1 : best + second + 2;
+
+    roots.push_back(c);
+    int root = *max_element(roots.begin(), roots.end(), [&](int a, int b) { return sizes[a] < sizes[b]; });
+    for (int r : roots)
+        parent[r] = root;
+    sizes[root] = size;
+    bounds[root] = min(bound, size - 1);
+    count -= static_cast<int>(roots.size()) - 1;
+    return root;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "dictionary.h"
+
+class WordGraph;
+
+// 单词图的连通分量，用来在搜索之前判断梯子是否可能存在。
+//
+// 按 generate_word_ladder 的规则，单向边只出现在去掉或替换掉非字母字符时，每走一条单向边，
+// 单词里非字母字符的个数（下面称为层级）就少一个；层级相同的单词之间的边总是双向的。
+// 所以这里只合并层级相同的相邻单词：同一分量内的单词两两可达，层级不同的分量之间只能从高层级走到低层级。
+// 每个分量还记录从代表单词出发的离心率 e，分量内任意两个单词的最短梯子不超过 min(2e, 大小 - 1) 步
+class WordComponents {
+public:
+    WordComponents() = default;
+    // 每个分量从 ID 最小的单词出发做一次 BFS，同时得到分量编号和离心率
+    WordComponents(const Dictionary& dictionary, const WordGraph& graph);
+    // 从索引文件恢复；数组会被复制，之后仍可以 add_word
+    WordComponents(span<const int> labels, span<const int> parents, span<const int> sizes, span<const int> bounds,
+                   span<const int> levels);
+
+    int num_words() const { return static_cast<int>(label.size()); }
+    int num_components() const { return count; }
+
+    // 单词所在分量的编号；add_word 合并分量后编号取并查集的根
+    int component(int id) const {
+        int c = label[id];
+        while (parent[c] != c)
+            c = parent[c];
+        return c;
+    }
+    int component_size(int c) const { return sizes[c]; }
+    int depth_bound(int c) const { return bounds[c]; }
+    int level(int c) const { return levels[c]; }
+
+    // 返回 false 时从 from 到 to 一定没有梯子；返回 true 时同一分量一定有，不同分量还要搜索才知道
+    bool may_reach(int from, int to) const {
+        int a = component(from), b = component(to);
+        return a == b || levels[a] > levels[b];
+    }
+    // 从 from 到 to 的最短梯子步数的上界，不在同一分量时为 -1（没有已知上界）
+    int distance_bound(int from, int to) const {
+        int c = component(from);
+        return c == component(to) ? bounds[c] : -1;
+    }
+
+    // 插入一个新单词，ID 为 id，原来 ID 不小于 id 的单词后移一位，与词典保持字典序一致；id 为 num_words() 时就是追加。
+    // neighbors 是它与其他单词之间任一方向的边（用插入后的编号），与它连通的分量按大小合并（并查集），
+    // 上界取 max(b1 + 1, b1 + b2 + 2)，b1、b2 是被连起来的最大两个上界。返回新单词所在分量
+    int add_word(int id, string_view word, span<const int> neighbors);
+
+    // 单词中非字母字符的个数
+    static int level_of(string_view word);
+
+    span<const int> labels_array() const { return label; }
+    span<const int> parents_array() const { return parent; }
+    span<const int> sizes_array() const { return sizes; }
+    span<const int> bounds_array() const { return bounds; }
+    span<const int> levels_array() const { return levels; }
+
+private:
+    vector<int> label;
+    vector<int> parent;
+    vector<int> sizes;
+    vector<int> bounds;
+    vector<int> levels;
+    int count = 0;
+};
@@ -0,0 +1,393 @@
+#include "word_index.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+struct WordGraphStorage {
+    vector<int> offsets;
+    vector<int> targets;
+    vector<int> reverseOffsets;
+    vector<int> sources;
+};
+
+bool is_letter(char c) {
+    return c >= 'a' && c <= 'z';
+}
+
+// 只去掉第 skip 个字符后的比较，不构造新字符串
+int compare_without(string_view a, string_view b, size_t skip) {
+    if (int c = a.substr(0, skip).compare(b.substr(0, skip)))
+        return c;
+    return a.substr(skip + 1).compare(b.substr(skip + 1));
+}
+
+// 依次从映射的文件中取出一段数组；各段的大小都是 4 的倍数，对齐由文件头之后的布局保证
+template <typename T>
+span<const T> take(const char*& p, size_t count) {
+    span<const T> s(reinterpret_cast<const T*>(p), count);
+    p += count * sizeof(T);
+    return s;
+}
+
+WordIndex map_word_index(shared_ptr<const MappedFile> file) {
+    WordIndexHeader header;
+    if (file->size() < sizeof(header))
+        throw runtime_error("Truncated word index file");
+    memcpy(&header, file->data(), sizeof(header));
+    if (memcmp(header.magic, WORD_INDEX_MAGIC, sizeof(header.magic)) != 0)
+        throw runtime_error("Not a word index file");
+    if (header.version != WORD_INDEX_VERSION)
+        throw runtime_error("Unsupported word index version");
+    if (header.numWords < 0 || header.numComponents < 0 || header.numSlots < 0 || header.numEdges < 0
+        || header.numEdges > INT_MAX || header.arenaBytes < 0 || header.arenaBytes > UINT32_MAX || header.numSlots > INT_MAX)
+        throw runtime_error("Malformed word index header");
+
+    size_t n = header.numWords;
+    size_t expected = sizeof(header) + (n + 1) * sizeof(uint32_t) + header.numSlots * sizeof(Dictionary::Slot)
+                    + 2 * ((n + 1) + header.numEdges) * sizeof(int32_t)
+                    + (n + 4 * static_cast<size_t>(header.numComponents)) * sizeof(int32_t) + header.arenaBytes;
+    if (file->size() != expected)
+        throw runtime_error("Truncated word index file");
+
+    const char* p = file->data() + sizeof(header);
+    auto word_offsets = take<uint32_t>(p, n + 1);
+    auto slots = take<Dictionary::Slot>(p, header.numSlots);
+    auto edge_offsets = take<int>(p, n + 1);
+    auto targets = take<int>(p, header.numEdges);
+    auto reverse_offsets = take<int>(p, n + 1);
+    auto sources = take<int>(p, header.numEdges);
+    auto labels = take<int>(p, n);
+    auto parents = take<int>(p, header.numComponents);
+    auto sizes = take<int>(p, header.numComponents);
+    auto bounds = take<int>(p, header.numComponents);
+    auto levels = take<int>(p, header.numComponents);
+    auto arena = take<char>(p, header.arenaBytes);
+
+    for (span<const int> ids : {targets, sources})
+        for (int v : ids)
+            if (v < 0 || v >= static_cast<int>(n))
+                throw runtime_error("Malformed word index edges");
+    WordIndex index;
+    index.dictionary = Dictionary(arena, word_offsets, slots, file);
+    index.graph = WordGraph(edge_offsets, targets, reverse_offsets, sources, std::move(file));
+    index.components = WordComponents(labels, parents, sizes, bounds, levels);
+    return index;
+}
+}
+
+WordGraph::WordGraph(vector<int> offsets, vector<int> targets) {
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != static_cast<int>(targets.size()))
+        throw runtime_error("Malformed word graph arrays");
+    int n = static_cast<int>(offsets.size()) - 1;
+    vector<int> reverse_offsets(n + 1, 0), sources(targets.size());
+    for (int v : targets)
+        ++reverse_offsets[v + 1];
+    for (int v = 0; v < n; ++v)
+        reverse_offsets[v + 1] += reverse_offsets[v];
+    // 按源点升序转置，每个单词的前驱同样按 ID 升序
+    vector<int> next(reverse_offsets.begin(), reverse_offsets.end() - 1);
+    for (int u = 0; u < n; ++u)
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i)
+            sources[next[targets[i]]++] = u;
+
+    auto owned = make_shared<WordGraphStorage>(WordGraphStorage{std::move(offsets), std::move(targets),
+                                                                std::move(reverse_offsets), std::move(sources)});
+    this->offsets = owned->offsets;
+    this->targets = owned->targets;
+    this->reverseOffsets = owned->reverseOffsets;
+    this->sources = owned->sources;
+    storage = std::move(owned);
+}
+
+WordGraph::WordGraph(span<const int> offsets, span<const int> targets, span<const int> reverse_offsets,
+                     span<const int> sources, shared_ptr<const void> owner)
+    : offsets(offsets), targets(targets), reverseOffsets(reverse_offsets), sources(sources), storage(std::move(owner)) {
+    auto valid = [](span<const int> off, span<const int> ids) {
+        return !off.empty() && off.front() == 0 && off.back() == static_cast<int>(ids.size())
+            && is_sorted(off.begin(), off.end());
+    };
+    if (!valid(offsets, targets) || !valid(reverse_offsets, sources) || reverse_offsets.size() != offsets.size())
+        throw runtime_error("Malformed word graph arrays");
+}
+
+WordGraph WordGraph::build(const Dictionary& dictionary) {
+    int n = dictionary.size();
+    vector<pair<int, int>> edges;
+
+    // 替换：同一长度的单词按“去掉第 i 位后的剩余部分”排序，相等的一段互为替换邻居
+    vector<vector<int>> by_length;
+    for (int id = 0; id < n; ++id) {
+        size_t len = dictionary.word(id).size();
+        if (by_length.size() <= len)
+            by_length.resize(len + 1);
+        by_length[len].push_back(id);
+    }
+    vector<int> bucket;
+    for (size_t len = 1; len < by_length.size(); ++len) {
+        for (size_t i = 0; i < len; ++i) {
+            bucket = by_length[len];
+            auto less = [&](int a, int b) { return compare_without(dictionary.word(a), dictionary.word(b), i) < 0; };
+            sort(bucket.begin(), bucket.end(), less);
+            for (size_t lo = 0, hi; lo < bucket.size(); lo = hi) {
+                for (hi = lo + 1; hi < bucket.size() && !less(bucket[lo], bucket[hi]); ++hi) {}
+                for (size_t x = lo; x < hi; ++x)
+                    for (size_t y = lo; y < hi; ++y)
+                        if (x != y && is_letter(dictionary.word(bucket[y])[i]))
+                            edges.emplace_back(bucket[x], bucket[y]);
+            }
+        }
+    }
+
+    // 删除与插入：删去一个字符后仍是单词的，长词到短词总有边，被删的是字母时短词到长词也有边
+    string shorter;
+    for (int id = 0; id < n; ++id) {
+        string_view w = dictionary.word(id);
+        for (size_t i = 0; i < w.size(); ++i) {
+            shorter.assign(w.substr(0, i));
+            shorter.append(w.substr(i + 1));
+            int s = dictionary.find(shorter);
+            if (s < 0)
+                continue;
+            edges.emplace_back(id, s);
+            if (is_letter(w[i]))
+                edges.emplace_back(s, id);
+        }
+    }
+
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+    vector<int> offsets(n + 1, 0), targets(edges.size());
+    for (size_t e = 0; e < edges.size(); ++e) {
+        ++offsets[edges[e].first + 1];
+        targets[e] = edges[e].second;
+    }
+    for (int u = 0; u < n; ++u)
+        offsets[u + 1] += offsets[u];
+    return WordGraph(std::move(offsets), std::move(targets));
+}
+
+WordIndex build_word_index(Dictionary dictionary) {
+    WordIndex index;
+    index.graph = WordGraph::build(dictionary);
+    index.components = WordComponents(dictionary, index.graph);
+    index.dictionary = std::move(dictionary);
+    return index;
+}
+
+int add_word(WordIndex& index, string_view word) {
+    string w(word);
+    transform(w.begin(), w.end(), w.begin(), ::tolower);
+    const Dictionary& dict = index.dictionary;
+    if (int id = dict.find(w); id >= 0)
+        return id;
+    if (w.empty())
+        throw runtime_error("Can't add an empty word");
+    int n = dict.size();
+    if (index.graph.num_words() != n || index.components.num_words() != n)
+        throw runtime_error("Word graph does not match dictionary");
+
+    // 新单词的 ID；原来 ID 不小于 pos 的单词后移一位，编号的相对顺序不变
+    int lo = 0, hi = n;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (dict.word(mid) < w) lo = mid + 1;
+        else hi = mid;
+    }
+    int pos = lo;
+    auto renumber = [&](int id) { return id + (id >= pos); };
+
+    // 与 WordGraph::build 相同的规则，逐个试探：out 是新单词一步能到的单词，in 是一步能到新单词的单词
+    vector<int> out, in;
+    string candidate;
+    auto probe = [&](vector<int>& ids) {
+        int id = dict.find(candidate);
+        if (id >= 0)
+            ids.push_back(renumber(id));
+    };
+    for (size_t i = 0; i < w.size(); ++i) {
+        candidate = w;
+        for (char c = 'a'; c <= 'z'; ++c) {
+            if (c == w[i]) continue;
+            candidate[i] = c;
+            probe(out);
+        }
+        if (is_letter(w[i])) {
+            for (char c : dict.alphabet()) {
+                if (c == w[i]) continue;
+                candidate[i] = c;
+                probe(in);
+            }
+        }
+        // 删去 w[i]：总能到短词，删去的是字母时短词也能插入回来
+        candidate.assign(w, 0, i);
+        candidate.append(w, i + 1);
+        probe(out);
+        if (is_letter(w[i]))
+            probe(in);
+    }
+    // 插入一个字符得到的长词：长词删去它就能到新单词，插入的是字母时新单词也能到长词
+    for (size_t i = 0; i <= w.size(); ++i) {
+        for (char c : dict.alphabet()) {
+            candidate.assign(w, 0, i);
+            candidate += c;
+            candidate.append(w, i);
+            probe(in);
+            if (is_letter(c))
+                probe(out);
+        }
+    }
+    for (vector<int>* ids : {&out, &in}) {
+        sort(ids->begin(), ids->end());
+        ids->erase(unique(ids->begin(), ids->end()), ids->end());
+    }
+
+    // 旧的每一行按新编号复制，前驱的行里按顺序插入 pos；新单词的行放在第 pos 行
+    vector<int> offsets{0}, targets;
+    targets.reserve(index.graph.num_edges() + out.size() + in.size());
+    auto copy_row = [&](int u) {
+        bool linked = binary_search(in.begin(), in.end(), renumber(u));
+        for (int v : index.graph.neighbors(u)) {
+            int r = renumber(v);
+            if (linked && r > pos) {
+                targets.push_back(pos);
+                linked = false;
+            }
+            targets.push_back(r);
+        }
+        if (linked)
+            targets.push_back(pos);
+        offsets.push_back(static_cast<int>(targets.size()));
+    };
+    for (int u = 0; u < pos; ++u)
+        copy_row(u);
+    targets.insert(targets.end(), out.begin(), out.end());
+    offsets.push_back(static_cast<int>(targets.size()));
+    for (int u = pos; u < n; ++u)
+        copy_row(u);
+
+    vector<int> adjacent;
+    set_union(out.begin(), out.end(), in.begin(), in.end(), back_inserter(adjacent));
+    vector<string_view> words;
+    words.reserve(n + 1);
+    for (int id = 0; id < n; ++id)
+        words.push_back(dict.word(id));
+    words.push_back(w);
+
+    Dictionary dictionary(std::move(words));
+    WordGraph graph(std::move(offsets), std::move(targets));
+    index.components.add_word(pos, w, adjacent);
+    index.dictionary = std::move(dictionary);
+    index.graph = std::move(graph);
+    return pos;
+}
+
+void save_word_index(const string& filename, const WordIndex& index) {
+    ofstream out(filename, ios::binary);
+    if (!out)
+        throw runtime_error("Can't open output file");
+
+    const Dictionary& dict = index.dictionary;
+    const WordComponents& components = index.components;
+    if (index.graph.num_words() != dict.size() || components.num_words() != dict.size())
+        throw runtime_error("Word graph does not match dictionary");
+    // 默认构造的词典和图没有偏移数组，写一个 0 保持格式一致
+    const uint32_t zero_word = 0;
+    const int zero_edge = 0;
+    span<const uint32_t> word_offsets = dict.offsets_array().empty() ? span(&zero_word, 1) : dict.offsets_array();
+    span<const int> edge_offsets = index.graph.offsets_array().empty() ? span(&zero_edge, 1) : index.graph.offsets_array();
+    span<const int> reverse_offsets = index.graph.offsets_array().empty() ? span(&zero_edge, 1)
+                                                                          : index.graph.reverse_offsets_array();
+
+    WordIndexHeader header{};
+    memcpy(header.magic, WORD_INDEX_MAGIC, sizeof(header.magic));
+    header.version = WORD_INDEX_VERSION;
+    header.numWords = dict.size();
+    header.numComponents = static_cast<int32_t>(components.parents_array().size());
+    header.numSlots = dict.slot_array().size();
+    header.numEdges = index.graph.num_edges();
+    header.arenaBytes = dict.arena_array().size();
+
+    auto write_array = [&](auto a) {
+        out.write(reinterpret_cast<const char*>(a.data()), a.size_bytes());
+    };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_array(word_offsets);
+    write_array(dict.slot_array());
+    write_array(edge_offsets);
+    write_array(index.graph.targets_array());
+    write_array(reverse_offsets);
+    write_array(index.graph.sources_array());
+    write_array(components.labels_array());
+    write_array(components.parents_array());
+    write_array(components.sizes_array());
+    write_array(components.bounds_array());
+    write_array(components.levels_array());
+    write_array(dict.arena_array());
+    if (!out)
+        throw runtime_error("Failed to write word index file");
+}
+
+void load_word_index(const string& filename, WordIndex& index) {
+    index = map_word_index(make_shared<const MappedFile>(filename));
+}
+
+string word_index_cache_path(const string& words_file) {
+    return words_file + ".idx";
+}
+
+bool load_fresh_word_index(const string& words_file, WordIndex& index) {
+    namespace fs = std::filesystem;
+    error_code ec;
+    auto words_time = fs::last_write_time(words_file, ec);
+    if (ec)
+        return false;
+    string cache = word_index_cache_path(words_file);
+    auto cache_time = fs::last_write_time(cache, ec);
+    if (ec || cache_time < words_time)
+        return false;
+    try {
+        load_word_index(cache, index);
+        return true;
+    } catch (const runtime_error&) {
+        // 缓存损坏或版本不对
+        return false;
+    }
+}
+
+void load_word_index_cached(const string& words_file, WordIndex& index, bool write_cache) {
+    namespace fs = std::filesystem;
+    if (load_fresh_word_index(words_file, index))
+        return;
+
+    string cache = word_index_cache_path(words_file);
+    error_code ec;
+    Dictionary dictionary;
+    load_words(dictionary, words_file);
+    index = build_word_index(std::move(dictionary));
+    if (!write_cache)
+        return;
+
+    // 每个进程写自己的临时文件再改名，其他进程不会映射到写了一半的缓存；目录不可写时只是不缓存
+    string temp = cache + ".XXXXXX";
+    int fd = mkstemp(temp.data());
+    if (fd < 0)
+        return;
+    fchmod(fd, 0644);
+    close(fd);
+    try {
+        save_word_index(temp, index);
+        fs::rename(temp, cache, ec);
+    } catch (const runtime_error&) {
+        ec = make_error_code(errc::io_error);
+    }
+    if (ec)
+        fs::remove(temp, ec);
+}
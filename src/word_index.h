@@ -0,0 +1,92 @@
+#pragma once
+
+#include "dictionary.h"
+#include "word_components.h"
+
+// 单词之间一步可达的关系，按单词 ID 组织成 CSR：neighbors(u) 按 ID（即字典序）升序排列。
+// 规则与 generate_word_ladder 的逐个试探相同：替换和插入只会产生 'a'..'z'，删除可以删去任意字符，
+// 所以含有其他字符（如 "o'brien"）的单词之间可能只有单向边；反向 BFS 用单独存放的 predecessors
+class WordGraph {
+public:
+    WordGraph() = default;
+    // 反向邻接由正向邻接转置得到
+    WordGraph(vector<int> offsets, vector<int> targets);
+    WordGraph(span<const int> offsets, span<const int> targets, span<const int> reverse_offsets,
+              span<const int> sources, shared_ptr<const void> owner);
+
+    // 用通配桶（同长度、只在第 i 位不同）找替换，用删除一个字符后查词典找插入和删除
+    static WordGraph build(const Dictionary& dictionary);
+
+    int num_words() const { return offsets.empty() ? 0 : static_cast<int>(offsets.size()) - 1; }
+    int num_edges() const { return static_cast<int>(targets.size()); }
+    span<const int> neighbors(int id) const {
+        return targets.subspan(offsets[id], offsets[id + 1] - offsets[id]);
+    }
+    span<const int> predecessors(int id) const {
+        return sources.subspan(reverseOffsets[id], reverseOffsets[id + 1] - reverseOffsets[id]);
+    }
+
+    span<const int> offsets_array() const { return offsets; }
+    span<const int> targets_array() const { return targets; }
+    span<const int> reverse_offsets_array() const { return reverseOffsets; }
+    span<const int> sources_array() const { return sources; }
+
+private:
+    span<const int> offsets;
+    span<const int> targets;
+    span<const int> reverseOffsets;
+    span<const int> sources;
+    shared_ptr<const void> storage;
+};
+
+// 词典加上预先算好的邻接关系和连通分量；单词梯子查询只在整数图上做 BFS，不连通时直接返回
+struct WordIndex {
+    Dictionary dictionary;
+    WordGraph graph;
+    WordComponents components;
+};
+
+WordIndex build_word_index(Dictionary dictionary);
+
+// 向索引中加入一个单词（先转成小写），返回它的 ID；已经存在时什么也不做。
+// 新单词按字典序插入，之后的单词 ID 加一，所以 ID 仍然是字典序；字典序最大的单词就是追加，取下一个 ID。
+// 只试探新单词一步可达的单词，邻接图的其余部分和连通分量都是增量更新（连通分量用 WordComponents::add_word），
+// 不重新计算整个图；但词典和邻接数组要复制一遍，代价与索引大小成正比
+int add_word(WordIndex& index, string_view word);
+
+// 索引文件（本机字节序），加载时整个文件 mmap，不做解析：
+//   WordIndexHeader
+//   uint32 wordOffsets[numWords + 1]
+//   Dictionary::Slot slots[numSlots]
+//   int32 edgeOffsets[numWords + 1]
+//   int32 targets[numEdges]
+//   int32 reverseOffsets[numWords + 1]
+//   int32 sources[numEdges]
+//   int32 componentLabels[numWords]
+//   int32 componentParents[numComponents], componentSizes[...], componentBounds[...], componentLevels[...]
+//   char arena[arenaBytes]
+// 连通分量的数组在加载时复制一份，之后仍然可以 add_word
+struct WordIndexHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t numWords;
+    int32_t numComponents;
+    int64_t numSlots;
+    int64_t numEdges;
+    int64_t arenaBytes;
+};
+
+constexpr char WORD_INDEX_MAGIC[4] = {'H', 'W', '9', 'W'};
+constexpr uint32_t WORD_INDEX_VERSION = 5;
+
+void save_word_index(const string& filename, const WordIndex& index);
+void load_word_index(const string& filename, WordIndex& index);
+
+// 缓存文件为 words_file + ".idx"，与词典在同一目录（words_file 是相对路径时就是当前目录）。
+// 缓存比词典新时直接映射，否则用 load_words 重建；只有 write_cache 为 true 时才把重建的索引写回缓存，
+// 写入先落到同目录下 mkstemp 生成的临时文件再改名，并发的进程不会互相覆盖或读到写了一半的文件
+string word_index_cache_path(const string& words_file);
+// 只映射已有的缓存：缓存存在、不比词典旧且能正确加载时返回 true，否则返回 false，不重建也不写文件。
+// 只回答一两个查询时，没有缓存就直接用 Dictionary 搜索，比先建整个索引快
+bool load_fresh_word_index(const string& words_file, WordIndex& index);
+void load_word_index_cached(const string& words_file, WordIndex& index, bool write_cache = false);
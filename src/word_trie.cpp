@@ -0,0 +1,30 @@
+#include "word_trie.h"
+
+WordTrie::WordTrie(Dictionary dictionary) : dict(std::move(dictionary)) {
+    // 按层构造：每个节点对应一段有公共前缀的单词 [lo, hi)，子节点追加在末尾，
+    // 所以同一个节点的子节点连续、按字符升序，且 firstChild 单调不减
+    struct Range {
+        int lo, hi, depth;
+    };
+    vector<Range> ranges{{0, dict.size(), 0}};
+    label.push_back(0);
+    for (size_t node = 0; node < ranges.size(); ++node) {
+        auto [lo, hi, depth] = ranges[node];
+        firstChild.push_back(static_cast<int>(ranges.size()));
+        // 恰好在这一层结束的单词排在最前面
+        if (lo < hi && static_cast<int>(dict.word(lo).size()) == depth)
+            wordId.push_back(lo++);
+        else
+            wordId.push_back(-1);
+        while (lo < hi) {
+            char c = dict.word(lo)[depth];
+            int end = lo + 1;
+            while (end < hi && dict.word(end)[depth] == c)
+                ++end;
+            ranges.push_back({lo, end, depth + 1});
+            label.push_back(c);
+            lo = end;
+        }
+    }
+    firstChild.push_back(static_cast<int>(ranges.size()));
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "dictionary.h"
+
+// 由排序后的词典按层构造的字典树，每个节点的子节点连续存放（CSR）、按字符升序排列。
+// 枚举一步可达的单词时沿单词本身往下走，只在存在的分支上尝试一次编辑，
+// 因此只产生词典里真的存在的单词，也不构造任何临时字符串；不需要预先算好的邻接索引
+class WordTrie {
+public:
+    WordTrie() = default;
+    explicit WordTrie(Dictionary dictionary);
+
+    const Dictionary& dictionary() const { return dict; }
+    int num_nodes() const { return static_cast<int>(label.size()); }
+
+    // 沿字典树查找，返回单词 ID 或 -1
+    int find(string_view w) const { return num_nodes() == 0 ? -1 : follow(0, w); }
+
+    // w 一步能变成的单词，规则与 generate_word_ladder 的试探相同：
+    // 替换和插入只产生 'a'..'z'，删除可以删去任意字符。同一个单词可能被报告多次。
+    // 返回试探过的分支数，调用方自己决定是否计入 LadderProbes
+    template <typename F>
+    uint64_t for_each_successor(string_view w, F&& f) const { return walk<false>(w, f); }
+
+    // 一步能变成 w 的单词，即 for_each_successor 的反方向
+    template <typename F>
+    uint64_t for_each_predecessor(string_view w, F&& f) const { return walk<true>(w, f); }
+
+private:
+    static bool is_letter(char c) { return c >= 'a' && c <= 'z'; }
+
+    int child(int node, char c) const {
+        for (int x = firstChild[node]; x < firstChild[node + 1]; ++x)
+            if (label[x] == c)
+                return x;
+        return -1;
+    }
+
+    // 从 node 开始精确匹配 rest，返回终点上的单词 ID 或 -1
+    int follow(int node, string_view rest) const {
+        for (char c : rest)
+            if ((node = child(node, c)) < 0)
+                return -1;
+        return wordId[node];
+    }
+
+    // 沿 w 的前缀往下走；在第 i 个位置上依次尝试插入、删除 w[i]、替换 w[i]，之后剩余部分必须精确匹配。
+    // Reverse 时允许的编辑对调：原单词一侧的字符只能是字母
+    template <bool Reverse, typename F>
+    uint64_t walk(string_view w, F& f) const {
+        if (num_nodes() == 0)
+            return 0;
+        uint64_t probes = 0;
+        auto emit = [&](int id) {
+            ++probes;
+            if (id >= 0)
+                f(id);
+        };
+        int node = 0;
+        for (size_t i = 0; i <= w.size(); ++i) {
+            string_view rest = w.substr(i);
+            for (int x = firstChild[node]; x < firstChild[node + 1]; ++x)
+                if (Reverse || is_letter(label[x]))
+                    emit(follow(x, rest));
+            if (i == w.size())
+                break;
+            if (!Reverse || is_letter(w[i]))
+                emit(follow(node, rest.substr(1)));
+            int next = -1;
+            for (int x = firstChild[node]; x < firstChild[node + 1]; ++x) {
+                if (label[x] == w[i])
+                    next = x;
+                else if (Reverse ? is_letter(w[i]) : is_letter(label[x]))
+                    emit(follow(x, rest.substr(1)));
+            }
+            if ((node = next) < 0)
+                break;
+        }
+        return probes;
+    }
+
+    Dictionary dict;
+    vector<int> firstChild;
+    vector<char> label;
+    vector<int> wordId;
+};